@@ -0,0 +1,158 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+class Arena {
+ private:
+  struct Block {
+    Block* next;
+    size_t size;
+  };
+
+  static constexpr size_t kDefaultBlockSize = 4096;
+  static constexpr size_t kMaxBlockSize = 1 << 20;
+
+  Block* blocks_ = nullptr;
+  char* cursor_ = nullptr;
+  char* end_ = nullptr;
+  size_t next_block_size_;
+  size_t bytes_used_ = 0;
+
+  static char* BlockData(Block* block) {
+    return reinterpret_cast<char*>(block + 1);
+  }
+
+  static char* AlignUp(char* pointer, size_t alignment) {
+    auto address = reinterpret_cast<uintptr_t>(pointer);
+    return pointer + ((alignment - address % alignment) % alignment);
+  }
+
+  void AddBlock(size_t min_size) {
+    size_t size = std::max(next_block_size_, min_size);
+    if (size > std::numeric_limits<size_t>::max() - sizeof(Block)) {
+      throw std::bad_alloc();
+    }
+    auto* block = static_cast<Block*>(operator new(sizeof(Block) + size));
+    blocks_ = new (block) Block{blocks_, size};
+    cursor_ = BlockData(block);
+    end_ = cursor_ + size;
+    next_block_size_ = std::min(next_block_size_ * 2, std::max(next_block_size_, kMaxBlockSize));
+  }
+
+  static void FreeBlocks(Block* block) noexcept {
+    while (block != nullptr) {
+      operator delete(std::exchange(block, block->next));
+    }
+  }
+
+ public:
+  explicit Arena(size_t block_size = kDefaultBlockSize) : next_block_size_(std::max<size_t>(block_size, 1)) {
+  }
+
+  Arena(const Arena& other) = delete;
+  Arena& operator=(const Arena& other) = delete;
+
+  ~Arena() {
+    FreeBlocks(blocks_);
+  }
+
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    char* result = cursor_ == nullptr ? nullptr : AlignUp(cursor_, alignment);
+    if (result == nullptr || size > static_cast<size_t>(end_ - result)) {
+      if (size > std::numeric_limits<size_t>::max() - (alignment - 1)) {
+        throw std::bad_alloc();
+      }
+      AddBlock(size + alignment - 1);
+      result = AlignUp(cursor_, alignment);
+    }
+    cursor_ = result + size;
+    bytes_used_ += size;
+    return result;
+  }
+
+  void Reset() noexcept {
+    if (blocks_ == nullptr) {
+      return;
+    }
+    Block* largest = blocks_;
+    for (Block* block = blocks_->next; block != nullptr; block = block->next) {
+      largest = block->size > largest->size ? block : largest;
+    }
+    for (Block* block = blocks_; block != nullptr;) {
+      Block* next = block->next;
+      if (block != largest) {
+        operator delete(block);
+      }
+      block = next;
+    }
+    largest->next = nullptr;
+    blocks_ = largest;
+    cursor_ = BlockData(blocks_);
+    end_ = cursor_ + blocks_->size;
+    bytes_used_ = 0;
+  }
+
+  [[nodiscard]] size_t BytesUsed() const noexcept {
+    return bytes_used_;
+  }
+
+  [[nodiscard]] size_t BlockCount() const noexcept {
+    size_t count = 0;
+    for (Block* block = blocks_; block != nullptr; block = block->next) {
+      ++count;
+    }
+    return count;
+  }
+};
+
+template <class T>
+class ArenaAllocator {
+ private:
+  Arena* arena_;
+
+  template <class U>
+  friend class ArenaAllocator;
+
+ public:
+  using value_type = T;                                            // NOLINT
+  using propagate_on_container_copy_assignment = std::false_type;  // NOLINT
+  using propagate_on_container_move_assignment = std::true_type;   // NOLINT
+  using propagate_on_container_swap = std::true_type;              // NOLINT
+  using is_always_equal = std::false_type;                         // NOLINT
+
+  ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {  // NOLINT
+  }
+
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {  // NOLINT
+  }
+
+  T* allocate(size_t count) {  // NOLINT
+    if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* /*pointer*/, size_t /*count*/) noexcept {  // NOLINT
+  }
+
+  [[nodiscard]] Arena& GetArena() const noexcept {
+    return *arena_;
+  }
+
+  template <class U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.arena_;
+  }
+
+  template <class U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ != other.arena_;
+  }
+};
@@ -1,5 +1,300 @@
-#include "cppstring.h"
+#include "CppString.h"
+#include "../Arena/Arena.h"
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#define CPP_STRING_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr size_t kVectorThreshold = 16;
+
+size_t MismatchScalar(const char* first, const char* second, size_t size) {
+  size_t idx = 0;
+  while (idx < size && first[idx] == second[idx]) {
+    ++idx;
+  }
+  return idx;
+}
+
+size_t FindByteScalar(const char* data, size_t size, char symbol) {
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] == symbol) {
+      return i;
+    }
+  }
+  return String::kNpos;
+}
+
+size_t FindScalar(const char* data, size_t size, const char* needle, size_t needle_size) {
+  for (size_t i = 0; i + needle_size <= size; ++i) {
+    if (data[i] == needle[0] && data[i + needle_size - 1] == needle[needle_size - 1] &&
+        std::memcmp(data + i + 1, needle + 1, needle_size - 2) == 0) {
+      return i;
+    }
+  }
+  return String::kNpos;
+}
+
+#ifdef CPP_STRING_X86_KERNELS
+
+size_t MismatchSse2(const char* first, const char* second, size_t size) {
+  size_t idx = 0;
+  for (; idx + 16 <= size; idx += 16) {
+    __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + idx));
+    __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + idx));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs))) ^ 0xFFFFu;
+    if (mask != 0) {
+      return idx + __builtin_ctz(mask);
+    }
+  }
+  return idx + MismatchScalar(first + idx, second + idx, size - idx);
+}
+
+size_t FindByteSse2(const char* data, size_t size, char symbol) {
+  __m128i pattern = _mm_set1_epi8(symbol);
+  size_t idx = 0;
+  for (; idx + 16 <= size; idx += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + idx));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+    if (mask != 0) {
+      return idx + __builtin_ctz(mask);
+    }
+  }
+  size_t tail = FindByteScalar(data + idx, size - idx, symbol);
+  return tail == String::kNpos ? tail : idx + tail;
+}
+
+size_t FindSse2(const char* data, size_t size, const char* needle, size_t needle_size) {
+  __m128i first = _mm_set1_epi8(needle[0]);
+  __m128i last = _mm_set1_epi8(needle[needle_size - 1]);
+  size_t idx = 0;
+  for (; idx + needle_size - 1 + 16 <= size; idx += 16) {
+    __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + idx));
+    __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + idx + needle_size - 1));
+    __m128i both = _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(both));
+    while (mask != 0) {
+      size_t candidate = idx + __builtin_ctz(mask);
+      if (std::memcmp(data + candidate + 1, needle + 1, needle_size - 2) == 0) {
+        return candidate;
+      }
+      mask &= mask - 1;
+    }
+  }
+  size_t tail = FindScalar(data + idx, size - idx, needle, needle_size);
+  return tail == String::kNpos ? tail : idx + tail;
+}
+
+__attribute__((target("avx2"))) size_t MismatchAvx2(const char* first, const char* second, size_t size) {
+  size_t idx = 0;
+  for (; idx + 32 <= size; idx += 32) {
+    __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + idx));
+    __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + idx));
+    unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)));
+    if (mask != 0) {
+      return idx + __builtin_ctz(mask);
+    }
+  }
+  _mm256_zeroupper();
+  return idx + MismatchSse2(first + idx, second + idx, size - idx);
+}
+
+__attribute__((target("avx2"))) size_t FindByteAvx2(const char* data, size_t size, char symbol) {
+  __m256i pattern = _mm256_set1_epi8(symbol);
+  size_t idx = 0;
+  for (; idx + 32 <= size; idx += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + idx));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+    if (mask != 0) {
+      return idx + __builtin_ctz(mask);
+    }
+  }
+  _mm256_zeroupper();
+  size_t tail = FindByteSse2(data + idx, size - idx, symbol);
+  return tail == String::kNpos ? tail : idx + tail;
+}
+
+__attribute__((target("avx2"))) size_t FindAvx2(const char* data, size_t size, const char* needle,
+                                                size_t needle_size) {
+  __m256i first = _mm256_set1_epi8(needle[0]);
+  __m256i last = _mm256_set1_epi8(needle[needle_size - 1]);
+  size_t idx = 0;
+  for (; idx + needle_size - 1 + 32 <= size; idx += 32) {
+    __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + idx));
+    __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + idx + needle_size - 1));
+    __m256i both = _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(both));
+    while (mask != 0) {
+      size_t candidate = idx + __builtin_ctz(mask);
+      if (std::memcmp(data + candidate + 1, needle + 1, needle_size - 2) == 0) {
+        return candidate;
+      }
+      mask &= mask - 1;
+    }
+  }
+  _mm256_zeroupper();
+  size_t tail = FindSse2(data + idx, size - idx, needle, needle_size);
+  return tail == String::kNpos ? tail : idx + tail;
+}
+
+#endif
+
+struct Kernels {
+  size_t (*mismatch)(const char*, const char*, size_t);
+  size_t (*find_byte)(const char*, size_t, char);
+  size_t (*find)(const char*, size_t, const char*, size_t);
+};
+
+Kernels SelectKernels() {
+#ifdef CPP_STRING_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {MismatchAvx2, FindByteAvx2, FindAvx2};
+  }
+  return {MismatchSse2, FindByteSse2, FindSse2};
+#else
+  return {MismatchScalar, FindByteScalar, FindScalar};
+#endif
+}
+
+const Kernels& ActiveKernels() {
+  static const Kernels kernels = SelectKernels();
+  return kernels;
+}
+
+size_t Mismatch(const char* first, const char* second, size_t size) {
+  if (size < kVectorThreshold) {
+    return MismatchScalar(first, second, size);
+  }
+  return ActiveKernels().mismatch(first, second, size);
+}
+
+size_t FindByte(const char* data, size_t size, char symbol) {
+  if (size < kVectorThreshold) {
+    return FindByteScalar(data, size, symbol);
+  }
+  return ActiveKernels().find_byte(data, size, symbol);
+}
+
+size_t FindBytes(const char* data, size_t size, const char* needle, size_t needle_size) {
+  if (size < needle_size + kVectorThreshold) {
+    return FindScalar(data, size, needle, needle_size);
+  }
+  return ActiveKernels().find(data, size, needle, needle_size);
+}
+
+constexpr uint64_t kHashSecret0 = 0xa0761d6478bd642fULL;
+constexpr uint64_t kHashSecret1 = 0xe7037ed1a0b428dbULL;
+constexpr uint64_t kHashSecret2 = 0x8ebc6af09c88c6e3ULL;
+constexpr uint64_t kHashSecret3 = 0x589965cc75374cc3ULL;
+
+void MultiplyFold(uint64_t& low, uint64_t& high) {
+#ifdef __SIZEOF_INT128__
+  __uint128_t product = static_cast<__uint128_t>(low) * high;
+  low = static_cast<uint64_t>(product);
+  high = static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t a_high = low >> 32;
+  uint64_t a_low = static_cast<uint32_t>(low);
+  uint64_t b_high = high >> 32;
+  uint64_t b_low = static_cast<uint32_t>(high);
+  uint64_t middle_first = a_high * b_low;
+  uint64_t middle_second = a_low * b_high;
+  uint64_t result_low = a_low * b_low;
+  uint64_t result_high = a_high * b_high;
+  uint64_t carry = (result_low >> 32) + static_cast<uint32_t>(middle_first) + static_cast<uint32_t>(middle_second);
+  low = (carry << 32) | static_cast<uint32_t>(result_low);
+  high = result_high + (middle_first >> 32) + (middle_second >> 32) + (carry >> 32);
+#endif
+}
+
+uint64_t Mix(uint64_t first, uint64_t second) {
+  MultiplyFold(first, second);
+  return first ^ second;
+}
+
+uint64_t Read64(const unsigned char* data) {
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint64_t Read32(const unsigned char* data) {
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+struct SharedHeader {
+  std::atomic<size_t> references{1};
+};
+
+SharedHeader* HeaderOf(char* data) {
+  return reinterpret_cast<SharedHeader*>(data - sizeof(SharedHeader));
+}
+
+constexpr size_t kMaxIoVectors = 1024;
+constexpr size_t kMaxIoChunk = static_cast<size_t>(1) << 30;
+
+}  // namespace
+
+size_t HashBytes(const char* data, size_t size) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  uint64_t seed = Mix(kHashSecret0, kHashSecret1);
+  uint64_t first = 0;
+  uint64_t second = 0;
+  if (size <= 16) {
+    if (size >= 4) {
+      size_t shift = (size >> 3) << 2;
+      first = (Read32(bytes) << 32) | Read32(bytes + shift);
+      second = (Read32(bytes + size - 4) << 32) | Read32(bytes + size - 4 - shift);
+    } else if (size > 0) {
+      first = (static_cast<uint64_t>(bytes[0]) << 16) | (static_cast<uint64_t>(bytes[size >> 1]) << 8) |
+              bytes[size - 1];
+    }
+  } else {
+    size_t rest = size;
+    if (rest > 48) {
+      uint64_t seed1 = seed;
+      uint64_t seed2 = seed;
+      do {
+        seed = Mix(Read64(bytes) ^ kHashSecret1, Read64(bytes + 8) ^ seed);
+        seed1 = Mix(Read64(bytes + 16) ^ kHashSecret2, Read64(bytes + 24) ^ seed1);
+        seed2 = Mix(Read64(bytes + 32) ^ kHashSecret3, Read64(bytes + 40) ^ seed2);
+        bytes += 48;
+        rest -= 48;
+      } while (rest > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (rest > 16) {
+      seed = Mix(Read64(bytes) ^ kHashSecret1, Read64(bytes + 8) ^ seed);
+      bytes += 16;
+      rest -= 16;
+    }
+    first = Read64(bytes + rest - 16);
+    second = Read64(bytes + rest - 8);
+  }
+  first ^= kHashSecret1;
+  second ^= seed;
+  MultiplyFold(first, second);
+  return static_cast<size_t>(Mix(first ^ kHashSecret0 ^ size, second ^ kHashSecret1));
+}
 
 size_t String::GetCStringSize(const char* string) const {
   size_t size = 0;
@@ -9,70 +304,156 @@ size_t String::GetCStringSize(const char* string) const {
   return size;
 }
 
-void String::CopyFromCString(const char* string, size_t size) {
-  if (capacity_ == 0 && size > 0) {
-    string_ = new char[2];
-    capacity_ = 2;
+bool String::IsInline() const {
+  return string_ == buffer_;
+}
+
+bool String::IsShared() const {
+  return capacity_ == kSharedCapacity;
+}
+
+void String::Share() {
+  if (IsInline() || IsShared()) {
+    return;
   }
+  char* block = new char[sizeof(SharedHeader) + size_];
+  new (block) SharedHeader{};
+  std::memcpy(block + sizeof(SharedHeader), string_, size_);
+  FreeBuffer(string_);
+  string_ = block + sizeof(SharedHeader);
+  capacity_ = kSharedCapacity;
+}
+
+void String::ShareFrom(const String& other) {
+  HeaderOf(other.string_)->references.fetch_add(1, std::memory_order_relaxed);
+  string_ = other.string_;
+  size_ = other.size_;
+  capacity_ = kSharedCapacity;
+}
+
+void String::ReleaseBuffer() {
+  if (IsShared()) {
+    SharedHeader* header = HeaderOf(string_);
+    if (header->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      header->~SharedHeader();
+      delete[] reinterpret_cast<char*>(header);
+    }
+  } else if (!IsInline()) {
+    FreeBuffer(string_);
+  }
+  string_ = buffer_;
+  capacity_ = kInlineCapacity;
+}
+
+void String::Detach() {
+  if (IsShared()) {
+    Reallocate(size_);
+  }
+}
+
+void String::CopyFromCString(const char* string, size_t size) {
   if (size > capacity_) {
-    Extend(size / capacity_ + 1);
+    size_ = 0;
+    Reallocate(size);
   }
-  for (size_t i = 0; i < size; ++i) {
-    string_[i] = string[i];
+  if (size > 0) {
+    std::memcpy(string_, string, size);
   }
 }
 
-String::String() : string_(nullptr), size_(0), capacity_(0) {
+String::String() : string_(buffer_), size_(0), capacity_(kInlineCapacity), arena_(nullptr) {
+}
+
+String::String(Arena* arena) : String() {
+  arena_ = arena;
 }
 
 String::String(const char* string) : String() {
-  capacity_ = size_ = GetCStringSize(string);
-  if (size_ != 0) {
-    string_ = new char[size_];
-  }
-  CopyFromCString(string, size_);
+  size_t size = GetCStringSize(string);
+  CopyFromCString(string, size);
+  size_ = size;
 }
 
 String::String(const String& other) : String() {
-  size_ = other.size_;
-  capacity_ = size_;
-  if (size_ != 0) {
-    string_ = new char[size_];
+  if (other.IsShared()) {
+    ShareFrom(other);
+    return;
   }
-  CopyFromCString(other.string_, size_);
+  CopyFromCString(other.string_, other.size_);
+  size_ = other.size_;
+}
+
+String::String(String&& other) noexcept : String() {
+  arena_ = other.arena_;
+  StealFrom(other);
 }
 
 String::String(const size_t size, const char symbol) : String() {
-  capacity_ = size_ = size;
-  if (size > 0) {
-    string_ = new char[size_];
+  if (size > capacity_) {
+    Reallocate(size);
   }
-  for (size_t i = 0; i < size_; ++i) {
+  for (size_t i = 0; i < size; ++i) {
     string_[i] = symbol;
   }
+  size_ = size;
 }
 
 String::String(const char* string, const size_t size) : String() {
-  capacity_ = size_ = size;
-  if (size_ != 0) {
-    string_ = new char[size_];
-  }
-  CopyFromCString(string, size_);
+  CopyFromCString(string, size);
+  size_ = size;
 }
 
 String::~String() {
-  delete[] string_;
+  ReleaseBuffer();
 }
 
 String& String::operator=(const String& other) {
-  if (this != &other) {
-    CopyFromCString(other.string_, other.size_);
-    size_ = capacity_ = other.size_;
+  if (this == &other) {
+    return *this;
+  }
+  if (other.IsShared()) {
+    if (string_ != other.string_) {
+      ReleaseBuffer();
+      ShareFrom(other);
+    }
+    size_ = other.size_;
+    return *this;
+  }
+  if (IsShared()) {
+    ReleaseBuffer();
+  }
+  CopyFromCString(other.string_, other.size_);
+  size_ = other.size_;
+  return *this;
+}
+
+String& String::operator=(String&& other) {
+  if (this == &other) {
+    return *this;
+  }
+  if (arena_ != other.arena_) {
+    return *this = static_cast<const String&>(other);
   }
+  ReleaseBuffer();
+  StealFrom(other);
   return *this;
 }
 
+void String::StealFrom(String& other) noexcept {
+  if (other.IsInline()) {
+    std::memcpy(buffer_, other.buffer_, other.size_);
+  } else {
+    string_ = other.string_;
+    capacity_ = other.capacity_;
+    other.string_ = other.buffer_;
+    other.capacity_ = kInlineCapacity;
+  }
+  size_ = other.size_;
+  other.size_ = 0;
+}
+
 char& String::operator[](size_t idx) {
+  Detach();
   return string_[idx];
 }
 
@@ -81,14 +462,12 @@ char String::operator[](size_t idx) const {
 }
 
 String operator+(const String& first, const String& second) {
-  String new_string;
-  for (size_t i = 0; i < first.size_; ++i) {
-    new_string.PushBack(first.string_[i]);
-  }
-  for (size_t i = first.size_; i < first.size_ + second.size_; ++i) {
-    new_string.PushBack(second.string_[i - first.size_]);
-  }
-  return new_string;
+  return Concat(first, second);
+}
+
+String operator+(String&& first, const String& second) {
+  first.Append(second);
+  return std::move(first);
 }
 
 char String::At(size_t idx) const {
@@ -102,10 +481,12 @@ char& String::At(size_t idx) {
   if (idx >= size_) {
     throw StringOutOfRange{};
   }
+  Detach();
   return string_[idx];
 }
 
 char& String::Front() {
+  Detach();
   return string_[0];
 }
 
@@ -114,6 +495,7 @@ char String::Front() const {
 }
 
 char& String::Back() {
+  Detach();
   return string_[size_ - 1];
 }
 
@@ -122,10 +504,12 @@ char String::Back() const {
 }
 
 char* String::CStr() {
+  Detach();
   return string_;
 }
 
 char* String::Data() {
+  Detach();
   return string_;
 }
 
@@ -154,131 +538,220 @@ size_t String::Size() const {
 }
 
 size_t String::Capacity() const {
-  return capacity_;
+  return IsShared() ? size_ : capacity_;
 }
 
 void String::Swap(String& other) {
-  auto tmp_size = size_;
-  auto tmp_capacity = capacity_;
-  auto tmp_string = string_;
-  string_ = other.string_;
-  capacity_ = other.capacity_;
-  size_ = other.size_;
-  other.size_ = tmp_size;
-  other.capacity_ = tmp_capacity;
-  other.string_ = tmp_string;
+  if (arena_ != other.arena_) {
+    String mine(arena_);
+    mine.Append(other);
+    String theirs(other.arena_);
+    theirs.Append(*this);
+    Swap(mine);
+    other.Swap(theirs);
+    return;
+  }
+  bool inline_this = IsInline();
+  bool inline_other = other.IsInline();
+  std::swap(string_, other.string_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(buffer_, other.buffer_);
+  if (inline_other) {
+    string_ = buffer_;
+  }
+  if (inline_this) {
+    other.string_ = other.buffer_;
+  }
 }
 
 void String::PopBack() {
   size_--;
 }
 
-void String::ExtendAndCopy(size_t multiply = 2) {
-  if (capacity_ == 0) {
-    string_ = new char[2];
-    capacity_ = 2;
-    return;
+char* String::AllocateBuffer(size_t capacity) {
+  if (arena_ != nullptr) {
+    return static_cast<char*>(arena_->Allocate(capacity, 1));
   }
-  capacity_ *= multiply;
-  char* old_string = string_;
-  string_ = new char[capacity_];
+  return new char[capacity];
+}
 
-  for (size_t i = 0; i < size_; ++i) {
-    string_[i] = old_string[i];
+void String::FreeBuffer(char* buffer) {
+  if (arena_ == nullptr) {
+    delete[] buffer;
   }
-  delete[] old_string;
 }
 
-void String::Extend(size_t multiply = 2) {
-  capacity_ *= multiply;
-  char* old_string = string_;
-  string_ = new char[capacity_];
-  delete[] old_string;
+void String::Reallocate(size_t new_capacity) {
+  char* new_string = new_capacity <= kInlineCapacity ? buffer_ : AllocateBuffer(new_capacity);
+  if (new_string == string_) {
+    return;
+  }
+  if (size_ > 0) {
+    std::memmove(new_string, string_, size_);
+  }
+  ReleaseBuffer();
+  string_ = new_string;
+  capacity_ = new_capacity <= kInlineCapacity ? kInlineCapacity : new_capacity;
+}
+
+void String::ExtendAndCopy(size_t multiply = 2) {
+  Reallocate(capacity_ * multiply);
+}
+
+void String::Grow(size_t min_capacity) {
+  Reallocate(std::max(capacity_ * 2, min_capacity));
 }
 
 void String::PushBack(char symbol) {
   if (size_ + 1 > capacity_) {
-    ExtendAndCopy();
+    Grow(size_ + 1);
   }
   string_[size_] = symbol;
   size_++;
 }
 
 String& String::operator+=(const String& other) {
-  for (size_t i = 0; i < other.size_; ++i) {
-    PushBack(other.string_[i]);
+  return Append(other);
+}
+
+String& String::Append(std::string_view string) {
+  if (size_ + string.size() > capacity_) {
+    // string may point into the buffer being released (self-append, or a block shared with the source),
+    // so both pieces go into the new buffer before the old one is let go.
+    size_t new_capacity = std::max(capacity_ * 2, size_ + string.size());
+    char* new_string = new_capacity <= kInlineCapacity ? buffer_ : AllocateBuffer(new_capacity);
+    if (size_ > 0) {
+      std::memcpy(new_string, string_, size_);
+    }
+    if (!string.empty()) {
+      std::memcpy(new_string + size_, string.data(), string.size());
+    }
+    ReleaseBuffer();
+    string_ = new_string;
+    capacity_ = new_capacity <= kInlineCapacity ? kInlineCapacity : new_capacity;
+    size_ += string.size();
+    return *this;
+  }
+  if (!string.empty()) {
+    std::memcpy(string_ + size_, string.data(), string.size());
   }
+  size_ += string.size();
   return *this;
 }
 
 void String::Resize(size_t new_size, char symbol) {
-  if (capacity_ == 0) {
-    string_ = new char[2];
-    capacity_ = 2;
-  }
+  Detach();
   if (new_size > capacity_) {
     ExtendAndCopy(new_size / capacity_ + 1);
-    for (auto i = size_; i < new_size; ++i) {
-      string_[i] = symbol;
-    }
+  }
+  for (auto i = size_; i < new_size; ++i) {
+    string_[i] = symbol;
   }
   size_ = new_size;
 }
 
 void String::Reserve(size_t new_capacity) {
+  Detach();
   if (capacity_ < new_capacity) {
-    ExtendAndCopy(new_capacity / capacity_ + 1);
+    Reallocate(new_capacity);
   }
 }
 
 void String::ShrinkToFit() {
-  if (size_ == 0) {
-    size_ = capacity_ = 0;
-    delete[] string_;
-    string_ = nullptr;
-    return;
+  if (!IsInline() && !IsShared() && size_ < capacity_) {
+    Reallocate(size_);
   }
-  char* old_string = string_;
-  string_ = new char[size_];
-  capacity_ = size_;
-  CopyFromCString(old_string, size_);
-  delete[] old_string;
 }
 
-bool operator<(const String& first, const String& second) {
-  for (size_t i = 0; i < first.size_ && i < second.size_; ++i) {
-    if (first.string_[i] < second.string_[i]) {
-      return true;
-    }
-    if (first.string_[i] > second.string_[i]) {
-      return false;
-    }
+int String::Compare(const String& other) const {
+  size_t common = std::min(size_, other.size_);
+  size_t idx = Mismatch(string_, other.string_, common);
+  if (idx < common) {
+    return string_[idx] < other.string_[idx] ? -1 : 1;
+  }
+  if (size_ == other.size_) {
+    return 0;
   }
-  return (first.size_ < second.size_);
+  return size_ < other.size_ ? -1 : 1;
 }
 
-bool operator==(const String& first, const String& second) {
-  if (first.size_ != second.size_) {
-    return false;
+size_t String::Find(char symbol, size_t pos) const {
+  if (pos >= size_) {
+    return kNpos;
   }
-  for (size_t i = 0; i < first.size_; ++i) {
-    if (first.string_[i] != second.string_[i]) {
-      return false;
-    }
+  size_t idx = FindByte(string_ + pos, size_ - pos, symbol);
+  return idx == kNpos ? kNpos : pos + idx;
+}
+
+size_t String::Find(std::string_view string, size_t pos) const {
+  if (pos > size_ || string.size() > size_ - pos) {
+    return kNpos;
+  }
+  if (string.empty()) {
+    return pos;
   }
-  return true;
+  if (string.size() == 1) {
+    return Find(string[0], pos);
+  }
+  size_t idx = FindBytes(string_ + pos, size_ - pos, string.data(), string.size());
+  return idx == kNpos ? kNpos : pos + idx;
 }
 
-bool operator>(const String& first, const String& second) {
-  for (size_t i = 0; i < first.size_ && i < second.size_; ++i) {
-    if (first.string_[i] > second.string_[i]) {
-      return true;
+size_t String::RFind(char symbol) const {
+  for (size_t i = size_; i > 0; --i) {
+    if (string_[i - 1] == symbol) {
+      return i - 1;
     }
-    if (first.string_[i] < second.string_[i]) {
-      return false;
+  }
+  return kNpos;
+}
+
+size_t String::RFind(std::string_view string) const {
+  if (string.size() > size_) {
+    return kNpos;
+  }
+  if (string.empty()) {
+    return size_;
+  }
+  for (size_t i = size_ - string.size() + 1; i > 0; --i) {
+    if (std::memcmp(string_ + i - 1, string.data(), string.size()) == 0) {
+      return i - 1;
     }
   }
-  return (first.size_ > second.size_);
+  return kNpos;
+}
+
+bool String::Contains(char symbol) const {
+  return Find(symbol) != kNpos;
+}
+
+bool String::Contains(std::string_view string) const {
+  return Find(string) != kNpos;
+}
+
+Arena* String::GetArena() const {
+  return arena_;
+}
+
+size_t String::Hash() const {
+  return HashBytes(string_, size_);
+}
+
+String::operator std::string_view() const {
+  return std::string_view(string_, size_);
+}
+
+bool operator<(const String& first, const String& second) {
+  return first.Compare(second) < 0;
+}
+
+bool operator==(const String& first, const String& second) {
+  return first.size_ == second.size_ && Mismatch(first.string_, second.string_, first.size_) == first.size_;
+}
+
+bool operator>(const String& first, const String& second) {
+  return first.Compare(second) > 0;
 }
 
 bool operator!=(const String& first, const String& second) {
@@ -294,8 +767,411 @@ bool operator<=(const String& first, const String& second) {
 }
 
 std::ostream& operator<<(std::ostream& os, const String& string) {
-  for (size_t i = 0; i < string.size_; ++i) {
-    os << string[i];
+  return os.write(string.string_, static_cast<std::streamsize>(string.size_));
+}
+
+size_t String::WriteTo(int fd) const {
+  size_t written = 0;
+  while (written < size_) {
+    ssize_t result = write(fd, string_ + written, std::min(size_ - written, kMaxIoChunk));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "String::WriteTo");
+    }
+    written += static_cast<size_t>(result);
+  }
+  return written;
+}
+
+size_t String::ReadFrom(int fd, size_t count) {
+  Reserve(size_ + count);
+  size_t total = 0;
+  while (total < count) {
+    ssize_t result = read(fd, string_ + size_, std::min(count - total, kMaxIoChunk));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "String::ReadFrom");
+    }
+    if (result == 0) {
+      break;
+    }
+    size_ += static_cast<size_t>(result);
+    total += static_cast<size_t>(result);
+  }
+  return total;
+}
+
+size_t WriteAll(int fd, const String* strings, size_t count) {
+  iovec vectors[kMaxIoVectors];
+  size_t written = 0;
+  size_t next = 0;
+  while (next < count) {
+    size_t batch = 0;
+    for (; batch < kMaxIoVectors && next < count; ++next) {
+      if (!strings[next].Empty()) {
+        vectors[batch].iov_base = const_cast<char*>(strings[next].Data());
+        vectors[batch].iov_len = strings[next].Size();
+        ++batch;
+      }
+    }
+    iovec* pending = vectors;
+    while (batch > 0) {
+      ssize_t result = writev(fd, pending, static_cast<int>(batch));
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), "WriteAll");
+      }
+      written += static_cast<size_t>(result);
+      auto rest = static_cast<size_t>(result);
+      while (batch > 0 && rest >= pending->iov_len) {
+        rest -= pending->iov_len;
+        ++pending;
+        --batch;
+      }
+      if (batch > 0) {
+        pending->iov_base = static_cast<char*>(pending->iov_base) + rest;
+        pending->iov_len -= rest;
+      }
+    }
+  }
+  return written;
+}
+
+size_t StringHash::operator()(std::string_view string) const {
+  return HashBytes(string.data(), string.size());
+}
+
+bool StringEqual::operator()(std::string_view first, std::string_view second) const {
+  return first == second;
+}
+
+size_t std::hash<String>::operator()(const String& string) const {
+  return StringHash{}(string);
+}
+
+size_t std::hash<StringView>::operator()(StringView string) const {
+  return string.Hash();
+}
+
+StringView::StringView() : string_(nullptr), size_(0) {
+}
+
+StringView::StringView(const char* string) : string_(string), size_(std::char_traits<char>::length(string)) {
+}
+
+StringView::StringView(const char* string, size_t size) : string_(string), size_(size) {
+}
+
+StringView::StringView(const String& string) : string_(string.Data()), size_(string.Size()) {
+}
+
+StringView::StringView(std::string_view string) : string_(string.data()), size_(string.size()) {
+}
+
+char StringView::operator[](size_t idx) const {
+  return string_[idx];
+}
+
+char StringView::At(size_t idx) const {
+  if (idx >= size_) {
+    throw StringOutOfRange{};
+  }
+  return string_[idx];
+}
+
+char StringView::Front() const {
+  return string_[0];
+}
+
+char StringView::Back() const {
+  return string_[size_ - 1];
+}
+
+const char* StringView::Data() const {
+  return string_;
+}
+
+bool StringView::Empty() const {
+  return size_ == 0;
+}
+
+size_t StringView::Length() const {
+  return size_;
+}
+
+size_t StringView::Size() const {
+  return size_;
+}
+
+void StringView::RemovePrefix(size_t count) {
+  string_ += count;
+  size_ -= count;
+}
+
+void StringView::RemoveSuffix(size_t count) {
+  size_ -= count;
+}
+
+StringView StringView::Substr(size_t pos, size_t count) const {
+  if (pos > size_) {
+    throw StringOutOfRange{};
+  }
+  return StringView(string_ + pos, std::min(count, size_ - pos));
+}
+
+bool StringView::StartsWith(StringView prefix) const {
+  return prefix.size_ <= size_ && Mismatch(string_, prefix.string_, prefix.size_) == prefix.size_;
+}
+
+bool StringView::EndsWith(StringView suffix) const {
+  return suffix.size_ <= size_ &&
+         Mismatch(string_ + size_ - suffix.size_, suffix.string_, suffix.size_) == suffix.size_;
+}
+
+StringView StringView::TrimLeft() const {
+  size_t begin = 0;
+  while (begin < size_ && std::isspace(static_cast<unsigned char>(string_[begin]))) {
+    ++begin;
+  }
+  return StringView(string_ + begin, size_ - begin);
+}
+
+StringView StringView::TrimRight() const {
+  size_t end = size_;
+  while (end > 0 && std::isspace(static_cast<unsigned char>(string_[end - 1]))) {
+    --end;
+  }
+  return StringView(string_, end);
+}
+
+StringView StringView::Trim() const {
+  return TrimLeft().TrimRight();
+}
+
+StringSplit StringView::Split(char delimiter) const {
+  return StringSplit(*this, delimiter);
+}
+
+StringSplit StringView::Split(StringView delimiter) const {
+  return StringSplit(*this, delimiter);
+}
+
+int StringView::Compare(StringView other) const {
+  size_t common = std::min(size_, other.size_);
+  size_t idx = Mismatch(string_, other.string_, common);
+  if (idx < common) {
+    return string_[idx] < other.string_[idx] ? -1 : 1;
+  }
+  if (size_ == other.size_) {
+    return 0;
+  }
+  return size_ < other.size_ ? -1 : 1;
+}
+
+size_t StringView::Find(char symbol, size_t pos) const {
+  if (pos >= size_) {
+    return kNpos;
+  }
+  size_t idx = FindByte(string_ + pos, size_ - pos, symbol);
+  return idx == kNpos ? kNpos : pos + idx;
+}
+
+size_t StringView::Find(StringView string, size_t pos) const {
+  if (pos > size_ || string.size_ > size_ - pos) {
+    return kNpos;
+  }
+  if (string.Empty()) {
+    return pos;
+  }
+  if (string.size_ == 1) {
+    return Find(string[0], pos);
+  }
+  size_t idx = FindBytes(string_ + pos, size_ - pos, string.string_, string.size_);
+  return idx == kNpos ? kNpos : pos + idx;
+}
+
+bool StringView::Contains(char symbol) const {
+  return Find(symbol) != kNpos;
+}
+
+bool StringView::Contains(StringView string) const {
+  return Find(string) != kNpos;
+}
+
+size_t StringView::Hash() const {
+  return HashBytes(string_, size_);
+}
+
+String StringView::ToString() const {
+  return String(string_, size_);
+}
+
+StringView::operator std::string_view() const {
+  return std::string_view(string_, size_);
+}
+
+bool operator<(StringView first, StringView second) {
+  return first.Compare(second) < 0;
+}
+
+bool operator==(StringView first, StringView second) {
+  return first.Size() == second.Size() && Mismatch(first.Data(), second.Data(), first.Size()) == first.Size();
+}
+
+bool operator>(StringView first, StringView second) {
+  return first.Compare(second) > 0;
+}
+
+bool operator!=(StringView first, StringView second) {
+  return !(first == second);
+}
+
+bool operator>=(StringView first, StringView second) {
+  return !(first < second);
+}
+
+bool operator<=(StringView first, StringView second) {
+  return !(first > second);
+}
+
+std::ostream& operator<<(std::ostream& os, StringView string) {
+  return os.write(string.Data(), static_cast<std::streamsize>(string.Size()));
+}
+
+StringSplit::StringSplit(StringView source, char delimiter)
+    : source_(source), delimiter_(), symbol_(delimiter), by_symbol_(true) {
+}
+
+StringSplit::StringSplit(StringView source, StringView delimiter)
+    : source_(source), delimiter_(delimiter), symbol_('\0'), by_symbol_(false) {
+  if (delimiter.Empty()) {
+    throw std::invalid_argument("StringSplit: empty delimiter");
+  }
+}
+
+StringSplit::Iterator StringSplit::begin() const {  // NOLINT
+  return Iterator(source_, delimiter_, symbol_, by_symbol_, 0);
+}
+
+StringSplit::Iterator StringSplit::end() const {  // NOLINT
+  return Iterator(source_, delimiter_, symbol_, by_symbol_, StringView::kNpos);
+}
+
+StringSplit::Iterator::Iterator(StringView source, StringView delimiter, char symbol, bool by_symbol, size_t pos)
+    : source_(source)
+    , delimiter_(delimiter)
+    , symbol_(symbol)
+    , by_symbol_(by_symbol)
+    , pos_(pos)
+    , end_(pos == StringView::kNpos ? pos : TokenEnd(pos)) {
+}
+
+size_t StringSplit::Iterator::TokenEnd(size_t pos) const {
+  size_t end = by_symbol_ ? source_.Find(symbol_, pos) : source_.Find(delimiter_, pos);
+  return end == StringView::kNpos ? source_.Size() : end;
+}
+
+size_t StringSplit::Iterator::DelimiterSize() const {
+  return by_symbol_ ? 1 : delimiter_.Size();
+}
+
+StringView StringSplit::Iterator::operator*() const {
+  return StringView(source_.Data() + pos_, end_ - pos_);
+}
+
+StringSplit::Iterator& StringSplit::Iterator::operator++() {
+  if (end_ == source_.Size()) {
+    pos_ = end_ = StringView::kNpos;
+  } else {
+    pos_ = end_ + DelimiterSize();
+    end_ = TokenEnd(pos_);
+  }
+  return *this;
+}
+
+StringSplit::Iterator StringSplit::Iterator::operator++(int) {
+  Iterator copy = *this;
+  ++*this;
+  return copy;
+}
+
+bool StringSplit::Iterator::operator==(const Iterator& other) const {
+  return pos_ == other.pos_;
+}
+
+bool StringSplit::Iterator::operator!=(const Iterator& other) const {
+  return !(*this == other);
+}
+
+StringBuilder::StringBuilder() : StringBuilder(kMinChunkCapacity) {
+}
+
+StringBuilder::StringBuilder(size_t capacity) : size_(0), next_capacity_(std::max(capacity, kMinChunkCapacity)) {
+}
+
+void StringBuilder::AddChunk(size_t min_capacity) {
+  chunks_.emplace_back();
+  chunks_.back().Reserve(std::max(next_capacity_, min_capacity));
+  next_capacity_ = std::min(next_capacity_ * 2, std::max(next_capacity_, kMaxChunkCapacity));
+}
+
+StringBuilder& StringBuilder::Append(const char* data, size_t size) {
+  while (size > 0) {
+    if (chunks_.empty() || chunks_.back().Size() == chunks_.back().Capacity()) {
+      AddChunk(size);
+    }
+    String& chunk = chunks_.back();
+    size_t part = std::min(size, chunk.Capacity() - chunk.Size());
+    chunk.Append(std::string_view(data, part));
+    data += part;
+    size -= part;
+    size_ += part;
+  }
+  return *this;
+}
+
+StringBuilder& StringBuilder::Append(StringView string) {
+  return Append(string.Data(), string.Size());
+}
+
+StringBuilder& StringBuilder::Append(char symbol) {
+  if (chunks_.empty() || chunks_.back().Size() == chunks_.back().Capacity()) {
+    AddChunk(1);
+  }
+  chunks_.back().PushBack(symbol);
+  ++size_;
+  return *this;
+}
+
+bool StringBuilder::Empty() const {
+  return size_ == 0;
+}
+
+size_t StringBuilder::Size() const {
+  return size_;
+}
+
+void StringBuilder::Clear() {
+  chunks_.clear();
+  size_ = 0;
+}
+
+String StringBuilder::Finish() {
+  String result;
+  if (chunks_.size() == 1) {
+    result = std::move(chunks_.front());
+  } else {
+    result.Reserve(size_);
+    for (const String& chunk : chunks_) {
+      result.Append(chunk);
+    }
   }
-  return os;
+  Clear();
+  return result;
 }
@@ -1,6 +1,12 @@
 #include <stdexcept>
 #pragma once
+#include <charconv>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 class StringOutOfRange : public std::out_of_range {
  public:
@@ -8,19 +14,25 @@ class StringOutOfRange : public std::out_of_range {
   }
 };
 
+class Arena;
+
 class String {
  public:
   String();
+  explicit String(Arena* arena);
   String(const size_t size, const char symbol);
   String(const char* string);  // NOLINT
   String(const char* string, const size_t size);
   String(const String& other);
+  String(String&& other) noexcept;
 
   ~String();
   char operator[](size_t idx) const;
   char& operator[](size_t idx);
   String& operator=(const String& other);
+  String& operator=(String&& other);
   String& operator+=(const String&);
+  String& Append(std::string_view string);
 
   char At(size_t idx) const;
   char& At(size_t idx);
@@ -43,17 +55,47 @@ class String {
   void Resize(size_t new_size, char symbol);
   void Reserve(size_t new_capacity);
   void ShrinkToFit();
+  void Share();
+  bool IsShared() const;
+  int Compare(const String& other) const;
+  size_t Find(char symbol, size_t pos = 0) const;
+  size_t Find(std::string_view string, size_t pos = 0) const;
+  size_t RFind(char symbol) const;
+  size_t RFind(std::string_view string) const;
+  bool Contains(char symbol) const;
+  bool Contains(std::string_view string) const;
+  size_t Hash() const;
+  size_t WriteTo(int fd) const;
+  size_t ReadFrom(int fd, size_t count);
+  Arena* GetArena() const;
+  operator std::string_view() const;  // NOLINT
+
+  static constexpr size_t kNpos = static_cast<size_t>(-1);
 
  private:
+  static constexpr size_t kInlineCapacity = 16;
+  static constexpr size_t kSharedCapacity = 0;
+
   char* string_;
   size_t size_;
   size_t capacity_;
+  char buffer_[kInlineCapacity];
+  Arena* arena_;
 
   size_t GetCStringSize(const char* string) const;
   void CopyFromCString(const char* string, size_t size);
-  void Extend(size_t multiply);
+  char* AllocateBuffer(size_t capacity);
+  void FreeBuffer(char* buffer);
+  void Reallocate(size_t new_capacity);
   void ExtendAndCopy(size_t multiply);
+  void Grow(size_t min_capacity);
+  bool IsInline() const;
+  void ShareFrom(const String& other);
+  void ReleaseBuffer();
+  void Detach();
+  void StealFrom(String& other) noexcept;
   friend String operator+(const String& first, const String& second);
+  friend String operator+(String&& first, const String& second);
   friend bool operator<(const String& first, const String& second);
   friend bool operator==(const String& first, const String& second);
   friend bool operator>(const String& first, const String& second);
@@ -64,6 +106,7 @@ class String {
 };
 
 String operator+(const String& first, const String& second);
+String operator+(String&& first, const String& second);
 bool operator<(const String& first, const String& second);
 bool operator==(const String& first, const String& second);
 bool operator>(const String& first, const String& second);
@@ -71,3 +114,172 @@ bool operator!=(const String& first, const String& second);
 bool operator>=(const String& first, const String& second);
 bool operator<=(const String& first, const String& second);
 std::ostream& operator<<(std::ostream& os, const String& string);
+
+size_t WriteAll(int fd, const String* strings, size_t count);
+
+template <class Strings>
+size_t WriteAll(int fd, const Strings& strings) {
+  return WriteAll(fd, strings.Data(), strings.Size());
+}
+
+class StringSplit;
+
+class StringView {
+ public:
+  StringView();
+  StringView(const char* string);  // NOLINT
+  StringView(const char* string, size_t size);
+  StringView(const String& string);  // NOLINT
+  StringView(std::string_view string);  // NOLINT
+
+  char operator[](size_t idx) const;
+  char At(size_t idx) const;
+  char Front() const;
+  char Back() const;
+  const char* Data() const;
+  bool Empty() const;
+  size_t Length() const;
+  size_t Size() const;
+  void RemovePrefix(size_t count);
+  void RemoveSuffix(size_t count);
+  StringView Substr(size_t pos, size_t count = kNpos) const;
+  bool StartsWith(StringView prefix) const;
+  bool EndsWith(StringView suffix) const;
+  StringView TrimLeft() const;
+  StringView TrimRight() const;
+  StringView Trim() const;
+  StringSplit Split(char delimiter) const;
+  StringSplit Split(StringView delimiter) const;
+  int Compare(StringView other) const;
+  size_t Find(char symbol, size_t pos = 0) const;
+  size_t Find(StringView string, size_t pos = 0) const;
+  bool Contains(char symbol) const;
+  bool Contains(StringView string) const;
+  size_t Hash() const;
+  String ToString() const;
+  operator std::string_view() const;  // NOLINT
+
+  static constexpr size_t kNpos = String::kNpos;
+
+ private:
+  const char* string_;
+  size_t size_;
+};
+
+bool operator<(StringView first, StringView second);
+bool operator==(StringView first, StringView second);
+bool operator>(StringView first, StringView second);
+bool operator!=(StringView first, StringView second);
+bool operator>=(StringView first, StringView second);
+bool operator<=(StringView first, StringView second);
+std::ostream& operator<<(std::ostream& os, StringView string);
+
+class StringSplit {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;  // NOLINT
+    using value_type = StringView;                        // NOLINT
+    using difference_type = std::ptrdiff_t;               // NOLINT
+    using pointer = const StringView*;                    // NOLINT
+    using reference = StringView;                         // NOLINT
+
+    Iterator() = default;
+    Iterator(StringView source, StringView delimiter, char symbol, bool by_symbol, size_t pos);
+
+    StringView operator*() const;
+    Iterator& operator++();
+    Iterator operator++(int);
+    bool operator==(const Iterator& other) const;
+    bool operator!=(const Iterator& other) const;
+
+   private:
+    StringView source_;
+    StringView delimiter_;
+    char symbol_ = '\0';
+    bool by_symbol_ = true;
+    size_t pos_ = StringView::kNpos;
+    size_t end_ = StringView::kNpos;
+
+    size_t TokenEnd(size_t pos) const;
+    size_t DelimiterSize() const;
+  };
+
+  StringSplit(StringView source, char delimiter);
+  StringSplit(StringView source, StringView delimiter);
+
+  Iterator begin() const;  // NOLINT
+  Iterator end() const;    // NOLINT
+
+ private:
+  StringView source_;
+  StringView delimiter_;
+  char symbol_;
+  bool by_symbol_;
+};
+
+template <class... Pieces>
+String Concat(const Pieces&... pieces) {
+  String result;
+  result.Reserve((std::string_view(pieces).size() + ... + 0));
+  (result.Append(pieces), ...);
+  return result;
+}
+
+size_t HashBytes(const char* data, size_t size);
+
+class StringBuilder {
+ public:
+  StringBuilder();
+  explicit StringBuilder(size_t capacity);
+
+  StringBuilder& Append(const char* data, size_t size);
+  StringBuilder& Append(StringView string);
+  StringBuilder& Append(char symbol);
+
+  template <class Number>
+  StringBuilder& AppendFormatted(Number value) {
+    static_assert(std::is_arithmetic_v<Number> && !std::is_same_v<Number, bool>, "AppendFormatted takes a number");
+    char buffer[kMaxFormattedSize];
+    auto result = std::to_chars(buffer, buffer + kMaxFormattedSize, value);
+    return Append(buffer, static_cast<size_t>(result.ptr - buffer));
+  }
+
+  bool Empty() const;
+  size_t Size() const;
+  void Clear();
+  String Finish();
+
+ private:
+  static constexpr size_t kMinChunkCapacity = 256;
+  static constexpr size_t kMaxChunkCapacity = 1 << 20;
+  static constexpr size_t kMaxFormattedSize = 64;
+
+  std::vector<String> chunks_;
+  size_t size_;
+  size_t next_capacity_;
+
+  void AddChunk(size_t min_capacity);
+};
+
+struct StringHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view string) const;
+};
+
+struct StringEqual {
+  using is_transparent = void;
+  bool operator()(std::string_view first, std::string_view second) const;
+};
+
+namespace std {
+template <>
+struct hash<String> {
+  size_t operator()(const String& string) const;
+};
+
+template <>
+struct hash<StringView> {
+  size_t operator()(StringView string) const;
+};
+}  // namespace std
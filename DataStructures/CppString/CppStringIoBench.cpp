@@ -0,0 +1,85 @@
+// Writing many mixed-size Strings to a file descriptor: WriteAll (one writev per kMaxIoVectors strings) against
+// String::WriteTo per string (one write each) and against operator<< into a std::ofstream. The strings are 8 bytes
+// to 4 KB long; a 64 MB set of them is written repeatedly until the requested total is reached.
+//   g++ -std=c++17 -O2 CppStringIoBench.cpp CppString.cpp -o string_io_bench && ./string_io_bench [MB] [path]
+// The default is 1024 MB to /dev/null, which measures the per-call cost; pass a file path to include the disk.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "CppString.h"
+
+namespace {
+
+constexpr size_t kSetBytes = 64 << 20;
+
+using Clock = std::chrono::steady_clock;
+
+void Row(const char *name, Clock::time_point start, size_t bytes, size_t calls) {
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  std::printf("%-12s %10.1f %10.1f %14zu\n", name, seconds * 1e3, bytes / seconds / (1 << 20), calls);
+}
+
+int OpenOutput(const char *path) {
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    std::perror(path);
+    std::exit(1);
+  }
+  return fd;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t total = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024) << 20;
+  const char *path = argc > 2 ? argv[2] : "/dev/null";
+  std::mt19937_64 random(1);
+  std::vector<String> strings;
+  size_t set_bytes = 0;
+  while (set_bytes < kSetBytes && set_bytes < total) {
+    size_t size = size_t{8} << (random() % 10);
+    size += random() % size;
+    strings.emplace_back(size, static_cast<char>('a' + random() % 26));
+    set_bytes += size;
+  }
+  size_t rounds = (total + set_bytes - 1) / set_bytes;
+  std::printf("%zu strings, %zu MB per round, %zu rounds to %s\n", strings.size(), set_bytes >> 20, rounds, path);
+  std::printf("%-12s %10s %10s %14s\n", "method", "total_ms", "MB/s", "strings");
+
+  int fd = OpenOutput(path);
+  auto start = Clock::now();
+  for (size_t round = 0; round < rounds; ++round) {
+    WriteAll(fd, strings.data(), strings.size());
+  }
+  close(fd);
+  Row("WriteAll", start, rounds * set_bytes, rounds * strings.size());
+
+  fd = OpenOutput(path);
+  start = Clock::now();
+  for (size_t round = 0; round < rounds; ++round) {
+    for (const auto &string : strings) {
+      string.WriteTo(fd);
+    }
+  }
+  close(fd);
+  Row("WriteTo", start, rounds * set_bytes, rounds * strings.size());
+
+  start = Clock::now();
+  {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    for (size_t round = 0; round < rounds; ++round) {
+      for (const auto &string : strings) {
+        stream << string;
+      }
+    }
+  }
+  Row("operator<<", start, rounds * set_bytes, rounds * strings.size());
+}
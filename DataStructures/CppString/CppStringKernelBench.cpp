@@ -0,0 +1,111 @@
+// String kernels against naive byte loops at lengths from 1 byte to 1 MB: operator==, Compare, Find(char),
+// Find(substring) and Hash. The searched symbol and substring are absent, so every call scans the whole string.
+// Each row runs about the same number of bytes in total and reports ns per call.
+//   g++ -std=c++17 -O2 CppStringKernelBench.cpp CppString.cpp -o string_kernel_bench && ./string_kernel_bench [MB]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+#include "CppString.h"
+
+namespace {
+
+size_t sink = 0;
+
+template <class Function>
+double NanosecondsPerCall(size_t iterations, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    sink += function();
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+bool NaiveEqual(std::string_view first, std::string_view second) {
+  if (first.size() != second.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < first.size(); ++i) {
+    if (first[i] != second[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int NaiveCompare(std::string_view first, std::string_view second) {
+  size_t size = first.size() < second.size() ? first.size() : second.size();
+  for (size_t i = 0; i < size; ++i) {
+    if (first[i] != second[i]) {
+      return static_cast<unsigned char>(first[i]) < static_cast<unsigned char>(second[i]) ? -1 : 1;
+    }
+  }
+  return first.size() == second.size() ? 0 : (first.size() < second.size() ? -1 : 1);
+}
+
+size_t NaiveFind(std::string_view string, char symbol) {
+  for (size_t i = 0; i < string.size(); ++i) {
+    if (string[i] == symbol) {
+      return i;
+    }
+  }
+  return String::kNpos;
+}
+
+size_t NaiveFind(std::string_view string, std::string_view needle) {
+  for (size_t i = 0; i + needle.size() <= string.size(); ++i) {
+    size_t j = 0;
+    while (j < needle.size() && string[i + j] == needle[j]) {
+      ++j;
+    }
+    if (j == needle.size()) {
+      return i;
+    }
+  }
+  return String::kNpos;
+}
+
+size_t NaiveHash(std::string_view string) {
+  size_t hash = 14695981039346656037ULL;
+  for (char symbol : string) {
+    hash = (hash ^ static_cast<unsigned char>(symbol)) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+void Row(const char *name, size_t size, double kernel, double naive) {
+  std::printf("%-12s %9zu %12.1f %12.1f %8.1fx\n", name, size, kernel, naive, naive / kernel);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t total_bytes = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256) << 20;
+  std::printf("~%zu MB scanned per row, ns per call\n", total_bytes >> 20);
+  std::printf("%-12s %9s %12s %12s %9s\n", "op", "bytes", "String", "naive", "speedup");
+  for (size_t size = 1; size <= (1 << 20); size *= 4) {
+    String first(size, 'a');
+    String second(size, 'a');
+    std::string_view first_view = first;
+    std::string_view second_view = second;
+    size_t iterations = total_bytes / size;
+    if (iterations > 20000000) {
+      iterations = 20000000;
+    }
+    Row("operator==", size, NanosecondsPerCall(iterations, [&] { return first == second; }),
+        NanosecondsPerCall(iterations, [&] { return NaiveEqual(first_view, second_view); }));
+    Row("Compare", size, NanosecondsPerCall(iterations, [&] { return first.Compare(second) == 0; }),
+        NanosecondsPerCall(iterations, [&] { return NaiveCompare(first_view, second_view) == 0; }));
+    Row("Find(char)", size, NanosecondsPerCall(iterations, [&] { return first.Find('b'); }),
+        NanosecondsPerCall(iterations, [&] { return NaiveFind(first_view, 'b'); }));
+    Row("Find(str)", size, NanosecondsPerCall(iterations, [&] { return first.Find("aab"); }),
+        NanosecondsPerCall(iterations, [&] { return NaiveFind(first_view, "aab"); }));
+    Row("Hash", size, NanosecondsPerCall(iterations, [&] { return first.Hash(); }),
+        NanosecondsPerCall(iterations, [&] { return NaiveHash(first_view); }));
+  }
+  if (sink == 1) {
+    std::printf("unlikely sink\n");
+  }
+}
@@ -0,0 +1,46 @@
+// Regression tests for String.
+//   g++ -std=c++17 -g -fsanitize=address,undefined CppStringTest.cpp CppString.cpp -o string_test && ./string_test
+
+#include <cassert>
+#include <string_view>
+
+#include "CppString.h"
+
+namespace {
+
+void AppendSharedSource() {
+  String a("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 23);
+  a.Share();
+  String b = a;
+  b.PopBack();
+  b.Append(a);
+  assert(std::string_view(b) == "ABCDEFGHIJKLMNOPQRSTUVABCDEFGHIJKLMNOPQRSTUVW");
+  assert(std::string_view(a) == "ABCDEFGHIJKLMNOPQRSTUVW");
+}
+
+void AppendSharedSourceToShortPrefix() {
+  String a("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 26);
+  a.Share();
+  String b = a;
+  while (b.Size() > 3) {
+    b.PopBack();
+  }
+  b.Append(std::string_view(a).substr(20));
+  assert(std::string_view(b) == "ABCUVWXYZ");
+}
+
+void AppendSelf() {
+  String a("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 20);
+  a.Append(a);
+  assert(std::string_view(a) == "ABCDEFGHIJKLMNOPQRSTABCDEFGHIJKLMNOPQRST");
+  a.Append(std::string_view(a).substr(10, 5));
+  assert(std::string_view(a) == "ABCDEFGHIJKLMNOPQRSTABCDEFGHIJKLMNOPQRSTKLMNO");
+}
+
+}  // namespace
+
+int main() {
+  AppendSharedSource();
+  AppendSharedSourceToShortPrefix();
+  AppendSelf();
+}
@@ -0,0 +1,77 @@
+// Building a multi-megabyte String from short pieces: StringBuilder against String::operator+= and against
+// `result = std::move(result) + piece`. The pieces alternate between a 12-byte literal and a number, the
+// pattern a log or CSV writer produces. Numbers are preformatted for every method; the last row lets
+// StringBuilder format them itself with AppendFormatted. Reports total ms and ns per appended piece.
+//   g++ -std=c++17 -O2 StringBuilderBench.cpp CppString.cpp -o string_builder_bench && ./string_builder_bench [MB]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CppString.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void Row(const char *name, double ms, size_t n_pieces, size_t size) {
+  std::printf("%-20s %10.1f %10.1f %12zu\n", name, ms, ms * 1e6 / n_pieces, size);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t target = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64) << 20;
+  const String label("value=12345,");
+  std::vector<String> numbers;
+  size_t n_pieces = 0;
+  for (size_t size = 0; size < target; ++n_pieces) {
+    numbers.emplace_back(std::to_string(n_pieces * 7919).c_str());
+    size += label.Size() + numbers.back().Size();
+  }
+  std::printf("%zu pieces, ~%zu MB output\n", 2 * n_pieces, target >> 20);
+  std::printf("%-20s %10s %10s %12s\n", "method", "total_ms", "ns/piece", "bytes");
+
+  auto start = Clock::now();
+  StringBuilder builder;
+  for (size_t i = 0; i < n_pieces; ++i) {
+    builder.Append(label).Append(numbers[i]);
+  }
+  String built = builder.Finish();
+  Row("StringBuilder", Milliseconds(start), 2 * n_pieces, built.Size());
+
+  start = Clock::now();
+  String appended;
+  for (size_t i = 0; i < n_pieces; ++i) {
+    appended += label;
+    appended += numbers[i];
+  }
+  Row("operator+=", Milliseconds(start), 2 * n_pieces, appended.Size());
+
+  start = Clock::now();
+  String concatenated;
+  for (size_t i = 0; i < n_pieces; ++i) {
+    concatenated = std::move(concatenated) + label;
+    concatenated = std::move(concatenated) + numbers[i];
+  }
+  Row("operator+ (moved)", Milliseconds(start), 2 * n_pieces, concatenated.Size());
+
+  start = Clock::now();
+  for (size_t i = 0; i < n_pieces; ++i) {
+    builder.Append(label).AppendFormatted(i * 7919);
+  }
+  String formatted = builder.Finish();
+  Row("AppendFormatted", Milliseconds(start), 2 * n_pieces, formatted.Size());
+
+  if (built != appended || built != concatenated || built != formatted) {
+    std::printf("outputs differ\n");
+    return 1;
+  }
+}
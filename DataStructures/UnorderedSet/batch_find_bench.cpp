@@ -0,0 +1,74 @@
+// FindBatch and InsertBatch against plain Find and Insert loops on a table larger than the last-level cache.
+// With n keys the chains and headers span hundreds of megabytes, so nearly every probe is a cache miss and
+// the gain comes from the prefetches overlapping them. Queries are random, half of them miss.
+//   g++ -std=c++17 -O2 batch_find_bench.cpp -o batch_find_bench && ./batch_find_bench [n]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "unordered_set.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsPerKey(Clock::time_point start, size_t n) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / n;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8000000;
+  std::mt19937_64 random(1);
+  std::vector<uint64_t> keys(n);
+  for (auto &key : keys) {
+    key = random() & ~uint64_t{1};
+  }
+  std::vector<uint64_t> queries(n);
+  for (auto &query : queries) {
+    query = keys[random() % n] | (random() & 1);
+  }
+
+  std::printf("%zu keys, ns per key\n", n);
+  std::printf("%-12s %10s %10s\n", "op", "loop", "batch");
+  UnorderedSet<uint64_t> loop_set;
+  loop_set.Reserve(n);
+  auto start = Clock::now();
+  for (auto key : keys) {
+    loop_set.Insert(key);
+  }
+  double insert_loop = NanosecondsPerKey(start, n);
+
+  UnorderedSet<uint64_t> batch_set;
+  batch_set.Reserve(n);
+  start = Clock::now();
+  batch_set.InsertBatch(keys.data(), n);
+  double insert_batch = NanosecondsPerKey(start, n);
+  std::printf("%-12s %10.2f %10.2f\n", "Insert", insert_loop, insert_batch);
+
+  size_t loop_found = 0;
+  start = Clock::now();
+  for (auto query : queries) {
+    loop_found += batch_set.Find(query) ? 1 : 0;
+  }
+  double find_loop = NanosecondsPerKey(start, n);
+
+  std::unique_ptr<bool[]> found(new bool[n]);
+  start = Clock::now();
+  batch_set.FindBatch(queries.data(), n, found.get());
+  double find_batch = NanosecondsPerKey(start, n);
+  size_t batch_found = 0;
+  for (size_t i = 0; i < n; ++i) {
+    batch_found += found[i] ? 1 : 0;
+  }
+  std::printf("%-12s %10.2f %10.2f\n", "Find", find_loop, find_batch);
+  if (loop_found != batch_found) {
+    std::printf("mismatch: %zu vs %zu\n", loop_found, batch_found);
+    return 1;
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef UNORDERED_SET_BUCKET_POLICY_H
+#define UNORDERED_SET_BUCKET_POLICY_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bucket_policy_detail {
+
+inline uint64_t MixHash(uint64_t hash) {
+  hash ^= hash >> 32;
+  hash *= 0x9e3779b97f4a7c15ULL;
+  hash ^= hash >> 29;
+  return hash;
+}
+
+inline uint64_t MulHigh64(uint64_t lhs, uint64_t rhs) {
+#ifdef __SIZEOF_INT128__
+  __extension__ using Uint128 = unsigned __int128;
+  return static_cast<uint64_t>((static_cast<Uint128>(lhs) * rhs) >> 64);
+#else
+  uint64_t lhs_lo = lhs & 0xFFFFFFFFULL;
+  uint64_t lhs_hi = lhs >> 32;
+  uint64_t rhs_lo = rhs & 0xFFFFFFFFULL;
+  uint64_t rhs_hi = rhs >> 32;
+  uint64_t lo_lo = lhs_lo * rhs_lo;
+  uint64_t hi_lo = lhs_hi * rhs_lo;
+  uint64_t lo_hi = lhs_lo * rhs_hi;
+  uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFULL) + lo_hi;
+  return lhs_hi * rhs_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+}  // namespace bucket_policy_detail
+
+struct ModuloBucketPolicy {
+  static size_t BucketCount(size_t requested) {
+    return requested;
+  }
+
+  static size_t Index(size_t hash, size_t n_bucket) {
+    return hash % n_bucket;
+  }
+};
+
+struct PowerOfTwoBucketPolicy {
+  static size_t BucketCount(size_t requested) {
+    if (requested == 0) {
+      return 0;
+    }
+    size_t n_bucket = 1;
+    while (n_bucket < requested) {
+      n_bucket *= 2;
+    }
+    return n_bucket;
+  }
+
+  static size_t Index(size_t hash, size_t n_bucket) {
+    return static_cast<size_t>(bucket_policy_detail::MixHash(hash)) & (n_bucket - 1);
+  }
+};
+
+struct FastRangeBucketPolicy {
+  static size_t BucketCount(size_t requested) {
+    return requested;
+  }
+
+  static size_t Index(size_t hash, size_t n_bucket) {
+    return static_cast<size_t>(bucket_policy_detail::MulHigh64(bucket_policy_detail::MixHash(hash), n_bucket));
+  }
+};
+
+#endif  // UNORDERED_SET_BUCKET_POLICY_H
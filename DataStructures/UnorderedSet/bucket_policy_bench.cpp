@@ -0,0 +1,77 @@
+// Per-lookup cost of the bucket policies: ModuloBucketPolicy (hash % n), PowerOfTwoBucketPolicy (mix and mask)
+// and FastRangeBucketPolicy (mix and multiply-high), for integer and string keys.
+// Queries are half hits and half misses; the small table fits in cache, so the reduction cost stands out there.
+//   g++ -std=c++17 -O2 bucket_policy_bench.cpp -o bucket_policy_bench && ./bucket_policy_bench [queries]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "unordered_set.h"
+
+namespace {
+
+template <class Key>
+Key MakeKey(uint64_t value);
+
+template <>
+uint64_t MakeKey<uint64_t>(uint64_t value) {
+  return value;
+}
+
+template <>
+std::string MakeKey<std::string>(uint64_t value) {
+  return "key:" + std::to_string(value);
+}
+
+template <class Key, class Policy>
+double NanosecondsPerLookup(size_t n_keys, const std::vector<uint64_t> &queries) {
+  UnorderedSet<Key, std::hash<Key>, std::equal_to<Key>, Policy> set;
+  for (uint64_t i = 0; i < n_keys; ++i) {
+    set.Insert(MakeKey<Key>(2 * i));
+  }
+  std::vector<Key> keys;
+  keys.reserve(queries.size());
+  for (auto query : queries) {
+    keys.push_back(MakeKey<Key>(query % (2 * n_keys)));
+  }
+  size_t found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &key : keys) {
+    found += set.Find(key) ? 1 : 0;
+  }
+  double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  if (found == 0) {
+    std::printf("no hits\n");
+  }
+  return elapsed / keys.size();
+}
+
+template <class Key>
+void Run(const char *key_name, size_t n_keys, const std::vector<uint64_t> &queries) {
+  double modulo = NanosecondsPerLookup<Key, ModuloBucketPolicy>(n_keys, queries);
+  double power_of_two = NanosecondsPerLookup<Key, PowerOfTwoBucketPolicy>(n_keys, queries);
+  double fast_range = NanosecondsPerLookup<Key, FastRangeBucketPolicy>(n_keys, queries);
+  std::printf("%-8s %10zu %10.2f %12.2f %12.2f\n", key_name, n_keys, modulo, power_of_two, fast_range);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t n_queries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+  std::mt19937_64 random(1);
+  std::vector<uint64_t> queries(n_queries);
+  for (auto &query : queries) {
+    query = random();
+  }
+  std::printf("ns per Find, %zu queries\n", n_queries);
+  std::printf("%-8s %10s %10s %12s %12s\n", "key", "keys", "modulo", "power_of_two", "fast_range");
+  for (size_t n_keys : {size_t{1} << 14, size_t{1} << 20}) {
+    Run<uint64_t>("uint64", n_keys, queries);
+    Run<std::string>("string", n_keys, queries);
+  }
+}
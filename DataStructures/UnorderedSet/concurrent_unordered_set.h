@@ -0,0 +1,137 @@
+#ifndef UNORDERED_SET_CONCURRENT_UNORDERED_SET_H
+#define UNORDERED_SET_CONCURRENT_UNORDERED_SET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+
+#include "unordered_set.h"
+
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class BucketPolicy = ModuloBucketPolicy>
+class ConcurrentUnorderedSet {
+ private:
+  using Set = UnorderedSet<Key, Hash, KeyEqual, BucketPolicy>;
+
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    Set set;
+  };
+
+  std::unique_ptr<Shard[]> shards_;
+  size_t n_shards_{};
+  size_t shard_shift_{};
+  Hash hash_{};
+
+ public:
+  using ValueType = Key;
+  using SizeType = size_t;
+  using Hasher = Hash;
+
+ public:
+  explicit ConcurrentUnorderedSet(size_t n_shards = 4 * std::max(1u, std::thread::hardware_concurrency()),
+                                  const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+      : hash_(hash) {
+    n_shards_ = 1;
+    size_t shard_bits = 0;
+    while (n_shards_ < n_shards) {
+      n_shards_ *= 2;
+      ++shard_bits;
+    }
+    shard_shift_ = 64 - shard_bits;
+    shards_ = std::make_unique<Shard[]>(n_shards_);
+    for (size_t i = 0; i < n_shards_; ++i) {
+      shards_[i].set = Set(0, hash, equal);
+    }
+  }
+
+  ConcurrentUnorderedSet(const ConcurrentUnorderedSet &other) = delete;
+  ConcurrentUnorderedSet &operator=(const ConcurrentUnorderedSet &other) = delete;
+
+  bool Insert(const ValueType &insert_value) {
+    size_t hash = hash_(insert_value);
+    auto &shard = ShardFor(hash);
+    std::unique_lock lock(shard.mutex);
+    return shard.set.InsertWithHash(hash, insert_value).second;
+  }
+
+  bool Insert(ValueType &&insert_value) {
+    size_t hash = hash_(insert_value);
+    auto &shard = ShardFor(hash);
+    std::unique_lock lock(shard.mutex);
+    return shard.set.InsertWithHash(hash, std::move(insert_value)).second;
+  }
+
+  size_t Erase(const ValueType &erase_value) {
+    size_t hash = hash_(erase_value);
+    auto &shard = ShardFor(hash);
+    std::unique_lock lock(shard.mutex);
+    return shard.set.EraseWithHash(hash, erase_value);
+  }
+
+  [[nodiscard]] bool Find(const ValueType &value) const {
+    size_t hash = hash_(value);
+    auto &shard = ShardFor(hash);
+    std::shared_lock lock(shard.mutex);
+    return shard.set.FindWithHash(hash, value);
+  }
+
+  [[nodiscard]] SizeType Size() const {
+    size_t size = 0;
+    for (size_t i = 0; i < n_shards_; ++i) {
+      std::shared_lock lock(shards_[i].mutex);
+      size += shards_[i].set.Size();
+    }
+    return size;
+  }
+
+  [[nodiscard]] bool Empty() const {
+    return Size() == 0;
+  }
+
+  void Clear() {
+    for (size_t i = 0; i < n_shards_; ++i) {
+      std::unique_lock lock(shards_[i].mutex);
+      shards_[i].set.Clear();
+    }
+  }
+
+  void Reserve(size_t new_bucket_count) {
+    for (size_t i = 0; i < n_shards_; ++i) {
+      std::unique_lock lock(shards_[i].mutex);
+      shards_[i].set.Reserve(new_bucket_count / n_shards_ + 1);
+    }
+  }
+
+  template <class Function>
+  void ForEach(Function function) {
+    for (size_t i = 0; i < n_shards_; ++i) {
+      std::unique_lock lock(shards_[i].mutex);
+      if (shards_[i].set.Empty()) {
+        continue;
+      }
+      for (auto &item : shards_[i].set) {
+        function(item);
+      }
+    }
+  }
+
+  [[nodiscard]] size_t ShardCount() const {
+    return n_shards_;
+  }
+
+ private:
+  Shard &ShardFor(size_t hash) const {
+    if (n_shards_ == 1) {
+      return shards_[0];
+    }
+    return shards_[(static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ULL) >> shard_shift_];
+  }
+};
+
+#endif  // UNORDERED_SET_CONCURRENT_UNORDERED_SET_H
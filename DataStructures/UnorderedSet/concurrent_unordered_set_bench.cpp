@@ -0,0 +1,95 @@
+// Throughput of ConcurrentUnorderedSet against one UnorderedSet behind a std::mutex, at 1, 2, 4, 8 and 16 threads.
+// Each thread runs a mix of 80% Find, 10% Insert and 10% Erase on random keys from a shared range.
+//   g++ -std=c++17 -O2 -pthread concurrent_unordered_set_bench.cpp -o concurrent_bench && ./concurrent_bench [ops]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "concurrent_unordered_set.h"
+
+namespace {
+
+constexpr uint64_t kKeyRange = 1 << 20;
+
+class LockedSet {
+ private:
+  std::mutex mutex_;
+  UnorderedSet<uint64_t> set_;
+
+ public:
+  bool Insert(uint64_t key) {
+    std::lock_guard lock(mutex_);
+    return set_.Insert(key).second;
+  }
+
+  size_t Erase(uint64_t key) {
+    std::lock_guard lock(mutex_);
+    return set_.Erase(key);
+  }
+
+  bool Find(uint64_t key) {
+    std::lock_guard lock(mutex_);
+    return set_.Find(key);
+  }
+};
+
+template <class Set>
+double OpsPerSecond(Set &set, size_t n_threads, size_t ops_per_thread) {
+  std::vector<std::thread> threads;
+  std::vector<size_t> found(n_threads);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t] {
+      std::mt19937_64 random(t + 1);
+      for (size_t i = 0; i < ops_per_thread; ++i) {
+        uint64_t value = random();
+        uint64_t key = value % kKeyRange;
+        switch (value >> 60) {
+          case 0:
+            set.Insert(key);
+            break;
+          case 1:
+            set.Erase(key);
+            break;
+          default:
+            found[t] += set.Find(key) ? 1 : 0;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return static_cast<double>(n_threads * ops_per_thread) / seconds;
+}
+
+template <class Set>
+void Prefill(Set &set) {
+  for (uint64_t key = 0; key < kKeyRange; key += 2) {
+    set.Insert(key);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t total_ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16000000;
+  std::printf("%zu ops per run, %u hardware threads\n", total_ops, std::thread::hardware_concurrency());
+  std::printf("%8s %16s %16s\n", "threads", "mutex Mops/s", "sharded Mops/s");
+  for (size_t n_threads : {1, 2, 4, 8, 16}) {
+    LockedSet locked;
+    Prefill(locked);
+    ConcurrentUnorderedSet<uint64_t> sharded;
+    sharded.Reserve(kKeyRange);
+    Prefill(sharded);
+    double locked_ops = OpsPerSecond(locked, n_threads, total_ops / n_threads);
+    double sharded_ops = OpsPerSecond(sharded, n_threads, total_ops / n_threads);
+    std::printf("%8zu %16.2f %16.2f\n", n_threads, locked_ops / 1e6, sharded_ops / 1e6);
+  }
+}
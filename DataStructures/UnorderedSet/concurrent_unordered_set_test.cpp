@@ -0,0 +1,78 @@
+// Stress test for ConcurrentUnorderedSet: threads insert, erase and find overlapping keys at the same time.
+// Build with ThreadSanitizer to check the shard locking:
+//   g++ -std=c++17 -O1 -g -fsanitize=thread concurrent_unordered_set_test.cpp -o concurrent_test && ./concurrent_test
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_unordered_set.h"
+
+namespace {
+
+constexpr int kThreads = 8;
+constexpr int kKeysPerThread = 20000;
+
+void DisjointKeys() {
+  ConcurrentUnorderedSet<int> set(16);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&set, t] {
+      for (int i = 0; i < kKeysPerThread; ++i) {
+        int key = i * kThreads + t;
+        assert(set.Insert(key));
+        assert(!set.Insert(key));
+        assert(set.Find(key));
+      }
+      for (int i = 0; i < kKeysPerThread; i += 2) {
+        assert(set.Erase(i * kThreads + t) == 1);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  assert(set.Size() == kThreads * kKeysPerThread / 2);
+  for (int key = 0; key < kThreads * kKeysPerThread; ++key) {
+    assert(set.Find(key) == (key / kThreads % 2 == 1));
+  }
+}
+
+void SharedKeys() {
+  constexpr int kKeys = 1000;
+  ConcurrentUnorderedSet<std::string> set(4);
+  std::atomic<int> inserted{0};
+  std::atomic<int> erased{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < kKeys; ++i) {
+          auto key = std::to_string(i);
+          if ((i + t + round) % 3 == 0) {
+            erased += static_cast<int>(set.Erase(key));
+          } else if (set.Insert(key)) {
+            ++inserted;
+          }
+          (void)set.Find(key);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  size_t size = 0;
+  set.ForEach([&size](const std::string &) { ++size; });
+  assert(size == set.Size());
+  assert(static_cast<int>(size) == inserted - erased);
+}
+
+}  // namespace
+
+int main() {
+  DisjointKeys();
+  SharedKeys();
+}
@@ -0,0 +1,227 @@
+#ifndef UNORDERED_SET_DENSE_UNORDERED_SET_H
+#define UNORDERED_SET_DENSE_UNORDERED_SET_H
+
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bucket_policy.h"
+
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class BucketPolicy = ModuloBucketPolicy>
+class DenseUnorderedSet {
+ private:
+  struct Link {
+    size_t hash;
+    size_t next;
+  };
+
+  static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+  std::vector<Key> keys_{};
+  std::vector<Link> links_{};
+  std::vector<size_t> buckets_{};
+  Hash hash_{};
+  KeyEqual equal_{};
+
+ public:
+  using ValueType = Key;
+  using SizeType = size_t;
+  using Hasher = Hash;
+  using KeyEqualType = KeyEqual;
+  using Reference = ValueType &;
+  using ConstReference = const ValueType &;
+  using IteratorSet = Key *;
+  using ConstIteratorSet = const Key *;
+
+ public:
+  DenseUnorderedSet() = default;
+
+  explicit DenseUnorderedSet(size_t count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+      : buckets_(BucketPolicy::BucketCount(count), kNone), hash_(hash), equal_(equal) {
+  }
+
+  template <class Iterator, class = std::enable_if_t<std::is_base_of_v<
+                                std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>>>
+  DenseUnorderedSet(Iterator first, Iterator second, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+      : DenseUnorderedSet(std::distance(first, second), hash, equal) {
+    keys_.reserve(buckets_.size());
+    links_.reserve(buckets_.size());
+    for (auto iter = first; iter != second; ++iter) {
+      Insert(*iter);
+    }
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return keys_.size();
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return keys_.empty();
+  }
+
+  IteratorSet begin() {  // NOLINT
+    return keys_.data();
+  }
+
+  IteratorSet end() {  // NOLINT
+    return keys_.data() + keys_.size();
+  }
+
+  ConstIteratorSet begin() const {  // NOLINT
+    return keys_.data();
+  }
+
+  ConstIteratorSet end() const {  // NOLINT
+    return keys_.data() + keys_.size();
+  }
+
+  ConstIteratorSet cbegin() const {  // NOLINT
+    return keys_.data();
+  }
+
+  ConstIteratorSet cend() const {  // NOLINT
+    return keys_.data() + keys_.size();
+  }
+
+  void Clear() {
+    keys_.clear();
+    links_.clear();
+    buckets_.clear();
+  }
+
+  [[nodiscard]] bool Find(const ValueType &value) const {
+    return FindIndex(value, hash_(value)) != kNone;
+  }
+
+  std::pair<IteratorSet, bool> Insert(const ValueType &insert_value) {
+    return EmplaceUnique(insert_value);
+  }
+
+  std::pair<IteratorSet, bool> Insert(ValueType &&insert_value) {
+    return EmplaceUnique(std::move(insert_value));
+  }
+
+  size_t Erase(const ValueType &erase_value) {
+    if (buckets_.empty()) {
+      return 0;
+    }
+    auto hash = hash_(erase_value);
+    size_t *link = &buckets_[BucketPolicy::Index(hash, buckets_.size())];
+    while (*link != kNone && !(links_[*link].hash == hash && equal_(keys_[*link], erase_value))) {
+      link = &links_[*link].next;
+    }
+    if (*link == kNone) {
+      return 0;
+    }
+    size_t idx = *link;
+    *link = links_[idx].next;
+    size_t last = keys_.size() - 1;
+    if (idx != last) {
+      size_t *last_link = &buckets_[BucketPolicy::Index(links_[last].hash, buckets_.size())];
+      while (*last_link != last) {
+        last_link = &links_[*last_link].next;
+      }
+      *last_link = idx;
+      keys_[idx] = std::move(keys_[last]);
+      links_[idx] = links_[last];
+    }
+    keys_.pop_back();
+    links_.pop_back();
+    return 1;
+  }
+
+  void Rehash(size_t new_bucket_count) {
+    if (new_bucket_count < keys_.size()) {
+      return;
+    }
+    new_bucket_count = BucketPolicy::BucketCount(new_bucket_count);
+    if (new_bucket_count == buckets_.size()) {
+      return;
+    }
+    buckets_.assign(new_bucket_count, kNone);
+    for (size_t idx = 0; idx < links_.size(); ++idx) {
+      auto &head = buckets_[BucketPolicy::Index(links_[idx].hash, new_bucket_count)];
+      links_[idx].next = head;
+      head = idx;
+    }
+  }
+
+  void Reserve(size_t new_bucket_count) {
+    keys_.reserve(new_bucket_count);
+    links_.reserve(new_bucket_count);
+    if (new_bucket_count > buckets_.size()) {
+      Rehash(new_bucket_count);
+    }
+  }
+
+  [[nodiscard]] SizeType BucketCount() const {
+    return buckets_.size();
+  }
+
+  [[nodiscard]] size_t BucketSize(size_t id) const {
+    if (id >= buckets_.size()) {
+      return 0;
+    }
+    size_t size = 0;
+    for (size_t idx = buckets_[id]; idx != kNone; idx = links_[idx].next) {
+      ++size;
+    }
+    return size;
+  }
+
+  [[nodiscard]] size_t Bucket(const ValueType &value) const {
+    return BucketPolicy::Index(hash_(value), buckets_.size());
+  }
+
+  [[nodiscard]] float LoadFactor() const {
+    return buckets_.empty() ? 0 : static_cast<float>(keys_.size()) / buckets_.size();
+  }
+
+  [[nodiscard]] Hasher HashFunction() const {
+    return hash_;
+  }
+
+  [[nodiscard]] KeyEqualType KeyEq() const {
+    return equal_;
+  }
+
+ private:
+  size_t FindIndex(const ValueType &value, size_t hash) const {
+    if (buckets_.empty()) {
+      return kNone;
+    }
+    size_t idx = buckets_[BucketPolicy::Index(hash, buckets_.size())];
+    while (idx != kNone && !(links_[idx].hash == hash && equal_(keys_[idx], value))) {
+      idx = links_[idx].next;
+    }
+    return idx;
+  }
+
+  template <class Value>
+  std::pair<IteratorSet, bool> EmplaceUnique(Value &&value) {
+    auto hash = hash_(value);
+    size_t idx = FindIndex(value, hash);
+    if (idx != kNone) {
+      return std::make_pair(keys_.data() + idx, false);
+    }
+    if (keys_.size() >= buckets_.size()) {
+      Rehash(BucketPolicy::BucketCount(buckets_.empty() ? 1 : 2 * buckets_.size()));
+    }
+    keys_.push_back(std::forward<Value>(value));
+    auto &head = buckets_[BucketPolicy::Index(hash, buckets_.size())];
+    try {
+      links_.push_back(Link{hash, head});
+    } catch (...) {
+      keys_.pop_back();
+      throw;
+    }
+    head = keys_.size() - 1;
+    return std::make_pair(keys_.data() + head, true);
+  }
+};
+
+#endif  // UNORDERED_SET_DENSE_UNORDERED_SET_H
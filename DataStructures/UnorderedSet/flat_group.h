@@ -0,0 +1,155 @@
+#ifndef UNORDERED_SET_FLAT_GROUP_H
+#define UNORDERED_SET_FLAT_GROUP_H
+
+#include <cstdint>
+#include <cstring>
+
+#if !defined(FLAT_UNORDERED_SET_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define FLAT_UNORDERED_SET_AVX2
+#elif !defined(FLAT_UNORDERED_SET_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define FLAT_UNORDERED_SET_SSE2
+#endif
+
+namespace flat_detail {
+
+using CtrlType = int8_t;
+
+inline constexpr CtrlType kEmpty = -128;
+inline constexpr CtrlType kDeleted = -2;
+inline constexpr CtrlType kSentinel = -1;
+
+inline bool IsFull(CtrlType ctrl) {
+  return ctrl >= 0;
+}
+
+template <size_t Width, size_t Shift>
+class BitMask {
+ private:
+  uint64_t mask_;
+
+ public:
+  explicit BitMask(uint64_t mask) : mask_(mask) {
+  }
+
+  explicit operator bool() const {
+    return mask_ != 0;
+  }
+
+  size_t LowestBitSet() const {
+    return static_cast<size_t>(__builtin_ctzll(mask_)) >> Shift;
+  }
+
+  size_t TrailingZeros() const {
+    return mask_ == 0 ? Width : LowestBitSet();
+  }
+
+  size_t LeadingZeros() const {
+    constexpr size_t kExtraBits = 64 - (Width << Shift);
+    return mask_ == 0 ? Width : static_cast<size_t>(__builtin_clzll(mask_ << kExtraBits)) >> Shift;
+  }
+
+  BitMask &operator++() {
+    mask_ &= mask_ - 1;
+    return *this;
+  }
+};
+
+#if defined(FLAT_UNORDERED_SET_AVX2)
+
+class GroupAvx2 {
+ private:
+  __m256i ctrl_;
+
+ public:
+  static constexpr size_t kWidth = 32;
+  using Mask = BitMask<kWidth, 0>;
+
+  explicit GroupAvx2(const CtrlType *pos) : ctrl_(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos))) {
+  }
+
+  Mask Match(CtrlType h2) const {
+    return Mask(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), ctrl_))));
+  }
+
+  Mask MaskEmpty() const {
+    return Match(kEmpty);
+  }
+
+  Mask MaskEmptyOrDeleted() const {
+    return Mask(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(kSentinel), ctrl_))));
+  }
+};
+
+using Group = GroupAvx2;
+
+#elif defined(FLAT_UNORDERED_SET_SSE2)
+
+class GroupSse2 {
+ private:
+  __m128i ctrl_;
+
+ public:
+  static constexpr size_t kWidth = 16;
+  using Mask = BitMask<kWidth, 0>;
+
+  explicit GroupSse2(const CtrlType *pos) : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {
+  }
+
+  Mask Match(CtrlType h2) const {
+    return Mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+  }
+
+  Mask MaskEmpty() const {
+    return Match(kEmpty);
+  }
+
+  Mask MaskEmptyOrDeleted() const {
+    return Mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_))));
+  }
+};
+
+using Group = GroupSse2;
+
+#else
+
+class GroupPortable {
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+  static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+  uint64_t ctrl_;
+
+ public:
+  static constexpr size_t kWidth = 8;
+  using Mask = BitMask<kWidth, 3>;
+
+  explicit GroupPortable(const CtrlType *pos) {
+    std::memcpy(&ctrl_, pos, sizeof(ctrl_));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    ctrl_ = __builtin_bswap64(ctrl_);
+#endif
+  }
+
+  Mask Match(CtrlType h2) const {
+    uint64_t value = ctrl_ ^ (kLsbs * static_cast<uint8_t>(h2));
+    return Mask((value - kLsbs) & ~value & kMsbs);
+  }
+
+  Mask MaskEmpty() const {
+    return Mask(ctrl_ & ~(ctrl_ << 6) & kMsbs);
+  }
+
+  Mask MaskEmptyOrDeleted() const {
+    return Mask(ctrl_ & ~(ctrl_ << 7) & kMsbs);
+  }
+};
+
+using Group = GroupPortable;
+
+#endif
+
+}  // namespace flat_detail
+
+#endif  // UNORDERED_SET_FLAT_GROUP_H
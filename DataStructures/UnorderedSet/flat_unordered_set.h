@@ -0,0 +1,480 @@
+#ifndef UNORDERED_SET_FLAT_UNORDERED_SET_H
+#define UNORDERED_SET_FLAT_UNORDERED_SET_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flat_group.h"
+
+namespace flat_detail {
+
+inline size_t MixHash(size_t hash) {
+  uint64_t value = static_cast<uint64_t>(hash);
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  return static_cast<size_t>(value);
+}
+
+inline size_t H1(size_t hash) {
+  return hash >> 7;
+}
+
+inline CtrlType H2(size_t hash) {
+  return static_cast<CtrlType>(hash & 0x7F);
+}
+
+inline size_t NormalizeCapacity(size_t count) {
+  size_t capacity = Group::kWidth - 1;
+  while (capacity < count) {
+    capacity = capacity * 2 + 1;
+  }
+  return capacity;
+}
+
+inline size_t CapacityToGrowth(size_t capacity) {
+  return capacity - (capacity + 1) / 8;
+}
+
+inline size_t NumCtrlBytes(size_t capacity) {
+  return capacity + Group::kWidth;
+}
+
+class ProbeSeq {
+ private:
+  size_t mask_;
+  size_t offset_;
+  size_t index_{};
+
+ public:
+  ProbeSeq(size_t hash, size_t mask) : mask_(mask), offset_(hash & mask) {
+  }
+
+  size_t Offset() const {
+    return offset_;
+  }
+
+  size_t Offset(size_t i) const {
+    return (offset_ + i) & mask_;
+  }
+
+  void Next() {
+    index_ += Group::kWidth;
+    offset_ = (offset_ + index_) & mask_;
+  }
+};
+
+inline size_t CapacityForSize(size_t count, size_t n_elements) {
+  size_t capacity = NormalizeCapacity(count);
+  while (CapacityToGrowth(capacity) < n_elements) {
+    capacity = capacity * 2 + 1;
+  }
+  return capacity;
+}
+
+}  // namespace flat_detail
+
+template <class Key>
+class FlatIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;  // NOLINT
+  using value_type = Key;                               // NOLINT
+  using difference_type = std::ptrdiff_t;               // NOLINT
+  using pointer = Key *;                                // NOLINT
+  using reference = Key &;                              // NOLINT
+
+ private:
+  const flat_detail::CtrlType *ctrl_;
+  Key *slot_;
+
+  void SkipEmptySlots() {
+    while (*ctrl_ != flat_detail::kSentinel && !flat_detail::IsFull(*ctrl_)) {
+      ++ctrl_;
+      ++slot_;
+    }
+  }
+
+ public:
+  FlatIterator(const flat_detail::CtrlType *ctrl, Key *slot) : ctrl_(ctrl), slot_(slot) {
+    if (ctrl_ != nullptr) {
+      SkipEmptySlots();
+    }
+  }
+
+  FlatIterator &operator++() {
+    ++ctrl_;
+    ++slot_;
+    SkipEmptySlots();
+    return *this;
+  }
+
+  FlatIterator operator++(int) {
+    auto copy_iterator = *this;
+    ++*this;
+    return copy_iterator;
+  }
+
+  Key *operator->() const {
+    return slot_;
+  }
+
+  Key &operator*() const {
+    return *slot_;
+  }
+
+  bool operator==(const FlatIterator &other) const {
+    return ctrl_ == other.ctrl_;
+  }
+
+  bool operator!=(const FlatIterator &other) const {
+    return !(*this == other);
+  }
+};
+
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatUnorderedSet {
+ private:
+  flat_detail::CtrlType *ctrl_{};
+  Key *slots_{};
+  size_t capacity_{};
+  size_t n_elements_{};
+  size_t growth_left_{};
+  Hash hash_{};
+  KeyEqual equal_{};
+
+ public:
+  using ValueType = Key;
+  using SizeType = size_t;
+  using Hasher = Hash;
+  using Reference = ValueType &;
+  using ConstReference = const ValueType &;
+  using IteratorSet = FlatIterator<Key>;
+
+ public:
+  FlatUnorderedSet() = default;
+
+  explicit FlatUnorderedSet(size_t count) {
+    if (count > 0) {
+      Allocate(flat_detail::NormalizeCapacity(count));
+    }
+  }
+
+  template <class Iterator, class = std::enable_if_t<std::is_base_of_v<
+                                std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>>>
+  FlatUnorderedSet(Iterator first, Iterator second) : FlatUnorderedSet(std::distance(first, second)) {
+    for (auto iter = first; iter != second; ++iter) {
+      Insert(*iter);
+    }
+  }
+
+  FlatUnorderedSet(const FlatUnorderedSet &other) : hash_(other.hash_), equal_(other.equal_) {
+    if (other.n_elements_ == 0) {
+      return;
+    }
+    Allocate(other.capacity_);
+    try {
+      for (size_t i = 0; i < other.capacity_; ++i) {
+        if (flat_detail::IsFull(other.ctrl_[i])) {
+          new (slots_ + i) Key(other.slots_[i]);
+          SetCtrl(i, other.ctrl_[i]);
+          ++n_elements_;
+        }
+      }
+    } catch (...) {
+      Destroy();
+      throw;
+    }
+    std::memcpy(ctrl_, other.ctrl_, flat_detail::NumCtrlBytes(capacity_));
+    growth_left_ = other.growth_left_;
+  }
+
+  FlatUnorderedSet(FlatUnorderedSet &&other) noexcept
+      : ctrl_(std::exchange(other.ctrl_, nullptr))
+      , slots_(std::exchange(other.slots_, nullptr))
+      , capacity_(std::exchange(other.capacity_, 0))
+      , n_elements_(std::exchange(other.n_elements_, 0))
+      , growth_left_(std::exchange(other.growth_left_, 0))
+      , hash_(std::move(other.hash_))
+      , equal_(std::move(other.equal_)){};
+
+  FlatUnorderedSet &operator=(const FlatUnorderedSet &other) {
+    if (this != &other) {
+      FlatUnorderedSet copy_set = other;
+      Swap(copy_set);
+    }
+    return *this;
+  };
+
+  FlatUnorderedSet &operator=(FlatUnorderedSet &&other) noexcept {
+    if (this != &other) {
+      Destroy();
+      ctrl_ = std::exchange(other.ctrl_, nullptr);
+      slots_ = std::exchange(other.slots_, nullptr);
+      capacity_ = std::exchange(other.capacity_, 0);
+      n_elements_ = std::exchange(other.n_elements_, 0);
+      growth_left_ = std::exchange(other.growth_left_, 0);
+      hash_ = std::move(other.hash_);
+      equal_ = std::move(other.equal_);
+    }
+    return *this;
+  };
+
+  ~FlatUnorderedSet() noexcept {
+    Destroy();
+  }
+
+  void Swap(FlatUnorderedSet &other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(n_elements_, other.n_elements_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return n_elements_;
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return n_elements_ == 0;
+  }
+
+  IteratorSet begin() {  // NOLINT
+    if (capacity_ == 0) {
+      return end();
+    }
+    return IteratorSet(ctrl_, slots_);
+  }
+
+  IteratorSet end() {  // NOLINT
+    if (capacity_ == 0) {
+      return IteratorSet(nullptr, nullptr);
+    }
+    return IteratorSet(ctrl_ + capacity_, slots_ + capacity_);
+  }
+
+  void Clear() {
+    Destroy();
+  }
+
+  [[nodiscard]] bool Find(const ValueType &value) const {
+    return FindIndex(value) != capacity_;
+  }
+
+  std::pair<IteratorSet, bool> Insert(const ValueType &insert_value) {
+    return EmplaceUnique(insert_value);
+  }
+
+  std::pair<IteratorSet, bool> Insert(ValueType &&insert_value) {
+    return EmplaceUnique(std::move(insert_value));
+  }
+
+  size_t Erase(const ValueType &erase_value) {
+    size_t idx = FindIndex(erase_value);
+    if (idx == capacity_) {
+      return 0;
+    }
+    slots_[idx].~Key();
+    --n_elements_;
+    auto empty_before = flat_detail::Group(ctrl_ + ((idx - flat_detail::Group::kWidth) & capacity_)).MaskEmpty();
+    auto empty_after = flat_detail::Group(ctrl_ + idx).MaskEmpty();
+    if (empty_before && empty_after &&
+        empty_before.LeadingZeros() + empty_after.TrailingZeros() < flat_detail::Group::kWidth) {
+      SetCtrl(idx, flat_detail::kEmpty);
+      ++growth_left_;
+    } else {
+      SetCtrl(idx, flat_detail::kDeleted);
+    }
+    return 1;
+  }
+
+  void Rehash(size_t new_bucket_count) {
+    if (new_bucket_count == 0 && n_elements_ == 0) {
+      Destroy();
+      return;
+    }
+    size_t new_capacity = flat_detail::CapacityForSize(new_bucket_count, n_elements_);
+    if (new_capacity == capacity_) {
+      return;
+    }
+    Resize(new_capacity);
+  }
+
+  void Reserve(size_t new_bucket_count) {
+    if (new_bucket_count > capacity_) {
+      Rehash(new_bucket_count);
+    }
+  }
+
+  [[nodiscard]] SizeType BucketCount() const {
+    return capacity_;
+  }
+
+  [[nodiscard]] float LoadFactor() const {
+    if (capacity_ == 0) {
+      return 0;
+    }
+    return static_cast<float>(n_elements_) / capacity_;
+  }
+
+ private:
+  size_t HashOf(const ValueType &value) const {
+    return flat_detail::MixHash(hash_(value));
+  }
+
+  static void SetCtrl(flat_detail::CtrlType *ctrl, size_t capacity, size_t idx, flat_detail::CtrlType value) {
+    constexpr size_t kClonedBytes = flat_detail::Group::kWidth - 1;
+    ctrl[idx] = value;
+    ctrl[((idx - kClonedBytes) & capacity) + kClonedBytes] = value;
+  }
+
+  void SetCtrl(size_t idx, flat_detail::CtrlType ctrl) {
+    SetCtrl(ctrl_, capacity_, idx, ctrl);
+  }
+
+  static std::pair<flat_detail::CtrlType *, Key *> AllocateArrays(size_t capacity) {
+    auto *ctrl = static_cast<flat_detail::CtrlType *>(operator new(flat_detail::NumCtrlBytes(capacity)));
+    Key *slots;
+    try {
+      slots = static_cast<Key *>(operator new(capacity * sizeof(Key), std::align_val_t{alignof(Key)}));
+    } catch (...) {
+      operator delete(ctrl);
+      throw;
+    }
+    std::memset(ctrl, static_cast<unsigned char>(flat_detail::kEmpty), flat_detail::NumCtrlBytes(capacity));
+    ctrl[capacity] = flat_detail::kSentinel;
+    return std::make_pair(ctrl, slots);
+  }
+
+  static void DestroyArrays(flat_detail::CtrlType *ctrl, Key *slots, size_t capacity) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<Key>) {
+      for (size_t i = 0; i < capacity; ++i) {
+        if (flat_detail::IsFull(ctrl[i])) {
+          slots[i].~Key();
+        }
+      }
+    }
+    operator delete(ctrl);
+    operator delete(slots, std::align_val_t{alignof(Key)});
+  }
+
+  void Allocate(size_t capacity) {
+    std::tie(ctrl_, slots_) = AllocateArrays(capacity);
+    capacity_ = capacity;
+    n_elements_ = 0;
+    growth_left_ = flat_detail::CapacityToGrowth(capacity);
+  }
+
+  void Destroy() noexcept {
+    if (capacity_ == 0) {
+      return;
+    }
+    DestroyArrays(ctrl_, slots_, capacity_);
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = n_elements_ = growth_left_ = 0;
+  }
+
+  size_t FindIndex(const ValueType &value) const {
+    if (n_elements_ == 0) {
+      return capacity_;
+    }
+    return FindIndex(value, HashOf(value));
+  }
+
+  size_t FindIndex(const ValueType &value, size_t hash) const {
+    flat_detail::CtrlType h2 = flat_detail::H2(hash);
+    for (flat_detail::ProbeSeq seq(flat_detail::H1(hash), capacity_);; seq.Next()) {
+      flat_detail::Group group(ctrl_ + seq.Offset());
+      for (auto match = group.Match(h2); match; ++match) {
+        size_t idx = seq.Offset(match.LowestBitSet());
+        if (equal_(slots_[idx], value)) {
+          return idx;
+        }
+      }
+      if (group.MaskEmpty()) {
+        return capacity_;
+      }
+    }
+  }
+
+  static size_t FindInsertSlot(const flat_detail::CtrlType *ctrl, size_t capacity, size_t hash) {
+    for (flat_detail::ProbeSeq seq(flat_detail::H1(hash), capacity);; seq.Next()) {
+      auto mask = flat_detail::Group(ctrl + seq.Offset()).MaskEmptyOrDeleted();
+      if (mask) {
+        return seq.Offset(mask.LowestBitSet());
+      }
+    }
+  }
+
+  size_t FindInsertSlot(size_t hash) const {
+    return FindInsertSlot(ctrl_, capacity_, hash);
+  }
+
+  // Elements are moved (or copied, if the move constructor may throw) into fresh arrays that replace the
+  // members only once every element is placed, so a throwing copy leaves the set unchanged.
+  void Resize(size_t new_capacity) {
+    auto [new_ctrl, new_slots] = AllocateArrays(new_capacity);
+    try {
+      for (size_t i = 0; i < capacity_; ++i) {
+        if (flat_detail::IsFull(ctrl_[i])) {
+          size_t hash = HashOf(slots_[i]);
+          size_t idx = FindInsertSlot(new_ctrl, new_capacity, hash);
+          new (new_slots + idx) Key(std::move_if_noexcept(slots_[i]));
+          SetCtrl(new_ctrl, new_capacity, idx, flat_detail::H2(hash));
+        }
+      }
+    } catch (...) {
+      DestroyArrays(new_ctrl, new_slots, new_capacity);
+      throw;
+    }
+    if (capacity_ > 0) {
+      DestroyArrays(ctrl_, slots_, capacity_);
+    }
+    ctrl_ = new_ctrl;
+    slots_ = new_slots;
+    capacity_ = new_capacity;
+    growth_left_ = flat_detail::CapacityToGrowth(new_capacity) - n_elements_;
+  }
+
+  void RehashForInsert() {
+    if (capacity_ == 0) {
+      Resize(flat_detail::NormalizeCapacity(1));
+    } else if (n_elements_ * 32 <= capacity_ * 25) {
+      Resize(capacity_);
+    } else {
+      Resize(capacity_ * 2 + 1);
+    }
+  }
+
+  template <class Value>
+  std::pair<IteratorSet, bool> EmplaceUnique(Value &&value) {
+    size_t hash = HashOf(value);
+    size_t idx = n_elements_ == 0 ? capacity_ : FindIndex(value, hash);
+    if (idx != capacity_) {
+      return std::make_pair(IteratorSet(ctrl_ + idx, slots_ + idx), false);
+    }
+    if (growth_left_ == 0) {
+      RehashForInsert();
+    }
+    idx = FindInsertSlot(hash);
+    new (slots_ + idx) Key(std::forward<Value>(value));
+    if (ctrl_[idx] == flat_detail::kEmpty) {
+      --growth_left_;
+    }
+    SetCtrl(idx, flat_detail::H2(hash));
+    ++n_elements_;
+    return std::make_pair(IteratorSet(ctrl_ + idx, slots_ + idx), true);
+  }
+};
+
+#endif  // UNORDERED_SET_FLAT_UNORDERED_SET_H
@@ -0,0 +1,52 @@
+// Insert tail latency of UnorderedSet with stop-the-world and incremental rehash.
+// Every insert is timed separately while the set grows to n elements, so the inserts that cross the
+// load factor and trigger a rehash show up in the p99/p999/max columns.
+//   g++ -std=c++17 -O2 incremental_rehash_bench.cpp -o incremental_rehash_bench && ./incremental_rehash_bench [n]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "unordered_set.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Percentile(std::vector<double> &sorted, double fraction) {
+  return sorted[std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()))];
+}
+
+void Run(const char *name, bool incremental, const std::vector<uint64_t> &keys) {
+  UnorderedSet<uint64_t> set;
+  set.SetIncrementalRehash(incremental);
+  std::vector<double> latencies(keys.size());
+  auto start = Clock::now();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto before = Clock::now();
+    set.Insert(keys[i]);
+    latencies[i] = std::chrono::duration<double, std::micro>(Clock::now() - before).count();
+  }
+  double total = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%-16s %10.1f %8.2f %8.2f %8.2f %10.1f %10zu\n", name, total, Percentile(latencies, 0.5),
+              Percentile(latencies, 0.99), Percentile(latencies, 0.999), latencies.back(), set.BucketCount());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+  std::mt19937_64 random(1);
+  std::vector<uint64_t> keys(n);
+  for (auto &key : keys) {
+    key = random();
+  }
+  std::printf("%zu inserts, latency in us\n", n);
+  std::printf("%-16s %10s %8s %8s %8s %10s %10s\n", "mode", "total_ms", "p50", "p99", "p999", "max", "buckets");
+  Run("stop-the-world", false, keys);
+  Run("incremental", true, keys);
+}
@@ -0,0 +1,354 @@
+#ifndef UNORDERED_SET_MAPPED_UNORDERED_SET_H
+#define UNORDERED_SET_MAPPED_UNORDERED_SET_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "unordered_set.h"
+
+namespace mapped_detail {
+
+inline constexpr char kMagic[8] = {'U', 'S', 'E', 'T', 'M', 'A', 'P', '1'};
+
+enum class KeyKind : uint64_t { kTrivial = 0, kBytes = 1 };
+
+struct Header {
+  char magic[8];
+  uint64_t kind;
+  uint64_t key_size;
+  uint64_t n_bucket;
+  uint64_t n_elements;
+  uint64_t blob_size;
+};
+
+template <class Key>
+constexpr KeyKind KindOf() {
+  static_assert(!std::is_pointer_v<Key>, "pointer keys cannot be mapped into another process");
+  static_assert(std::is_trivially_copyable_v<Key> || std::is_convertible_v<const Key &, std::string_view>,
+                "mapped keys must be trivially copyable or convertible to std::string_view");
+  return std::is_convertible_v<const Key &, std::string_view> ? KeyKind::kBytes : KeyKind::kTrivial;
+}
+
+inline size_t Align8(size_t size) {
+  return (size + 7) / 8 * 8;
+}
+
+inline void AddSection(size_t &total, uint64_t count, size_t width) {
+  if (count > (SIZE_MAX - 7) / width) {
+    throw std::runtime_error("MappedUnorderedSet: corrupt header");
+  }
+  size_t bytes = Align8(static_cast<size_t>(count) * width);
+  if (bytes > SIZE_MAX - total) {
+    throw std::runtime_error("MappedUnorderedSet: corrupt header");
+  }
+  total += bytes;
+}
+
+inline void CheckOffsets(const uint64_t *offsets, size_t count, uint64_t last) {
+  if (offsets[0] != 0 || offsets[count - 1] != last) {
+    throw std::runtime_error("MappedUnorderedSet: corrupt offsets");
+  }
+  for (size_t i = 1; i < count; ++i) {
+    if (offsets[i] < offsets[i - 1]) {
+      throw std::runtime_error("MappedUnorderedSet: corrupt offsets");
+    }
+  }
+}
+
+inline void WritePadded(std::ofstream &out, const void *data, size_t size) {
+  static constexpr char kZeros[8] = {};
+  out.write(static_cast<const char *>(data), size);
+  out.write(kZeros, Align8(size) - size);
+}
+
+}  // namespace mapped_detail
+
+template <class Key, class Hash, class KeyEqual, class BucketPolicy, class Allocator>
+void SaveMapped(const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &set, const std::string &path) {
+  constexpr auto kKind = mapped_detail::KindOf<Key>();
+  std::vector<const Key *> keys;
+  std::vector<uint64_t> hashes;
+  keys.reserve(set.Size());
+  hashes.reserve(set.Size());
+  set.ForEachWithHash([&](const Key &key, size_t key_hash) {
+    keys.push_back(&key);
+    hashes.push_back(key_hash);
+  });
+  size_t n_bucket = set.BucketCount();
+  std::vector<uint64_t> bucket_offsets(n_bucket + 1);
+  for (auto key_hash : hashes) {
+    ++bucket_offsets[BucketPolicy::Index(key_hash, n_bucket) + 1];
+  }
+  for (size_t i = 0; i < n_bucket; ++i) {
+    bucket_offsets[i + 1] += bucket_offsets[i];
+  }
+  std::vector<size_t> order(keys.size());
+  std::vector<uint64_t> sorted_hashes(keys.size());
+  std::vector<uint64_t> fill(bucket_offsets.begin(), bucket_offsets.end() - 1);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    size_t pos = fill[BucketPolicy::Index(hashes[i], n_bucket)]++;
+    order[pos] = i;
+    sorted_hashes[pos] = hashes[i];
+  }
+
+  std::vector<char> key_bytes;
+  std::vector<uint64_t> key_offsets;
+  std::string blob;
+  if constexpr (kKind == mapped_detail::KeyKind::kTrivial) {
+    key_bytes.resize(keys.size() * sizeof(Key));
+    for (size_t pos = 0; pos < order.size(); ++pos) {
+      std::memcpy(key_bytes.data() + pos * sizeof(Key), keys[order[pos]], sizeof(Key));
+    }
+  } else {
+    key_offsets.resize(keys.size() + 1);
+    for (size_t pos = 0; pos < order.size(); ++pos) {
+      std::string_view view = *keys[order[pos]];
+      blob.append(view.data(), view.size());
+      key_offsets[pos + 1] = blob.size();
+    }
+  }
+
+  mapped_detail::Header header{};
+  std::memcpy(header.magic, mapped_detail::kMagic, sizeof(header.magic));
+  header.kind = static_cast<uint64_t>(kKind);
+  header.key_size = sizeof(Key);
+  header.n_bucket = n_bucket;
+  header.n_elements = keys.size();
+  header.blob_size = blob.size();
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("SaveMapped: cannot open " + path);
+  }
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(bucket_offsets.data()), bucket_offsets.size() * sizeof(uint64_t));
+  out.write(reinterpret_cast<const char *>(sorted_hashes.data()), sorted_hashes.size() * sizeof(uint64_t));
+  if constexpr (kKind == mapped_detail::KeyKind::kTrivial) {
+    mapped_detail::WritePadded(out, key_bytes.data(), key_bytes.size());
+  } else {
+    out.write(reinterpret_cast<const char *>(key_offsets.data()), key_offsets.size() * sizeof(uint64_t));
+    mapped_detail::WritePadded(out, blob.data(), blob.size());
+  }
+  if (!out.flush()) {
+    throw std::runtime_error("SaveMapped: write failed for " + path);
+  }
+}
+
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class BucketPolicy = ModuloBucketPolicy>
+class MappedUnorderedSet {
+ private:
+  static constexpr auto kKind = mapped_detail::KindOf<Key>();
+
+  void *mapping_{};
+  size_t mapping_size_{};
+  size_t n_bucket_{};
+  size_t n_elements_{};
+  const uint64_t *bucket_offsets_{};
+  const uint64_t *hashes_{};
+  const char *keys_{};
+  const uint64_t *key_offsets_{};
+  const char *blob_{};
+  Hash hash_{};
+  KeyEqual equal_{};
+
+ public:
+  using ValueType = Key;
+  using SizeType = size_t;
+  using Hasher = Hash;
+  using PromotedSet = UnorderedSet<Key, Hash, KeyEqual, BucketPolicy>;
+
+ public:
+  explicit MappedUnorderedSet(const std::string &path, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+      : hash_(hash), equal_(equal) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("MappedUnorderedSet: cannot open " + path);
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(mapped_detail::Header)) {
+      close(fd);
+      throw std::runtime_error("MappedUnorderedSet: bad file " + path);
+    }
+    mapping_size_ = file_stat.st_size;
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping_ == MAP_FAILED) {
+      mapping_ = nullptr;
+      throw std::runtime_error("MappedUnorderedSet: mmap failed for " + path);
+    }
+    try {
+      Bind();
+    } catch (...) {
+      munmap(mapping_, mapping_size_);
+      throw;
+    }
+  }
+
+  MappedUnorderedSet(const MappedUnorderedSet &other) = delete;
+  MappedUnorderedSet &operator=(const MappedUnorderedSet &other) = delete;
+
+  MappedUnorderedSet(MappedUnorderedSet &&other) noexcept
+      : mapping_(std::exchange(other.mapping_, nullptr))
+      , mapping_size_(std::exchange(other.mapping_size_, 0))
+      , n_bucket_(std::exchange(other.n_bucket_, 0))
+      , n_elements_(std::exchange(other.n_elements_, 0))
+      , bucket_offsets_(other.bucket_offsets_)
+      , hashes_(other.hashes_)
+      , keys_(other.keys_)
+      , key_offsets_(other.key_offsets_)
+      , blob_(other.blob_)
+      , hash_(std::move(other.hash_))
+      , equal_(std::move(other.equal_)) {
+  }
+
+  MappedUnorderedSet &operator=(MappedUnorderedSet &&other) noexcept {
+    if (this != &other) {
+      MappedUnorderedSet moved(std::move(other));
+      std::swap(mapping_, moved.mapping_);
+      std::swap(mapping_size_, moved.mapping_size_);
+      std::swap(n_bucket_, moved.n_bucket_);
+      std::swap(n_elements_, moved.n_elements_);
+      std::swap(bucket_offsets_, moved.bucket_offsets_);
+      std::swap(hashes_, moved.hashes_);
+      std::swap(keys_, moved.keys_);
+      std::swap(key_offsets_, moved.key_offsets_);
+      std::swap(blob_, moved.blob_);
+      std::swap(hash_, moved.hash_);
+      std::swap(equal_, moved.equal_);
+    }
+    return *this;
+  }
+
+  ~MappedUnorderedSet() {
+    if (mapping_ != nullptr) {
+      munmap(mapping_, mapping_size_);
+    }
+  }
+
+  [[nodiscard]] bool Find(const ValueType &value) const {
+    if (n_bucket_ == 0) {
+      return false;
+    }
+    auto hash = static_cast<uint64_t>(hash_(value));
+    auto idx = BucketPolicy::Index(hash, n_bucket_);
+    for (size_t pos = bucket_offsets_[idx]; pos < bucket_offsets_[idx + 1]; ++pos) {
+      if (hashes_[pos] == hash && KeyEquals(pos, value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class Function>
+  void ForEach(Function function) const {
+    for (size_t pos = 0; pos < n_elements_; ++pos) {
+      if constexpr (kKind == mapped_detail::KeyKind::kTrivial) {
+        function(KeyAt(pos));
+      } else {
+        function(BytesAt(pos));
+      }
+    }
+  }
+
+  // Keys that only view their bytes (std::string_view) would point into the mapping and dangle once it is
+  // unmapped, so Promote() requires an owning key type such as std::string.
+  PromotedSet Promote() const {
+    static_assert(kKind == mapped_detail::KeyKind::kTrivial || !std::is_trivially_copyable_v<Key>,
+                  "Promote() needs a key type that owns its bytes; view keys would reference the mapping");
+    PromotedSet set(n_bucket_, hash_, equal_);
+    for (size_t pos = 0; pos < n_elements_; ++pos) {
+      if constexpr (kKind == mapped_detail::KeyKind::kTrivial) {
+        set.Insert(KeyAt(pos));
+      } else {
+        auto bytes = BytesAt(pos);
+        set.Insert(Key(bytes.data(), bytes.size()));
+      }
+    }
+    return set;
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return n_elements_;
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return n_elements_ == 0;
+  }
+
+  [[nodiscard]] SizeType BucketCount() const noexcept {
+    return n_bucket_;
+  }
+
+ private:
+  void Bind() {
+    mapped_detail::Header header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    if (std::memcmp(header.magic, mapped_detail::kMagic, sizeof(header.magic)) != 0 ||
+        header.kind != static_cast<uint64_t>(kKind) || header.key_size != sizeof(Key)) {
+      throw std::runtime_error("MappedUnorderedSet: format or key type mismatch");
+    }
+    if (header.n_bucket >= SIZE_MAX || header.n_elements >= SIZE_MAX) {
+      throw std::runtime_error("MappedUnorderedSet: corrupt header");
+    }
+    size_t expected = sizeof(header);
+    mapped_detail::AddSection(expected, header.n_bucket + 1, sizeof(uint64_t));
+    mapped_detail::AddSection(expected, header.n_elements, sizeof(uint64_t));
+    if constexpr (kKind == mapped_detail::KeyKind::kTrivial) {
+      mapped_detail::AddSection(expected, header.n_elements, sizeof(Key));
+    } else {
+      mapped_detail::AddSection(expected, header.n_elements + 1, sizeof(uint64_t));
+      mapped_detail::AddSection(expected, header.blob_size, 1);
+    }
+    if (expected != mapping_size_) {
+      throw std::runtime_error("MappedUnorderedSet: truncated file");
+    }
+    n_bucket_ = header.n_bucket;
+    n_elements_ = header.n_elements;
+    const char *cursor = static_cast<const char *>(mapping_) + sizeof(header);
+    bucket_offsets_ = reinterpret_cast<const uint64_t *>(cursor);
+    cursor += (n_bucket_ + 1) * sizeof(uint64_t);
+    hashes_ = reinterpret_cast<const uint64_t *>(cursor);
+    cursor += n_elements_ * sizeof(uint64_t);
+    if constexpr (kKind == mapped_detail::KeyKind::kTrivial) {
+      keys_ = cursor;
+    } else {
+      key_offsets_ = reinterpret_cast<const uint64_t *>(cursor);
+      blob_ = cursor + (n_elements_ + 1) * sizeof(uint64_t);
+      mapped_detail::CheckOffsets(key_offsets_, n_elements_ + 1, header.blob_size);
+    }
+    mapped_detail::CheckOffsets(bucket_offsets_, n_bucket_ + 1, n_elements_);
+  }
+
+  Key KeyAt(size_t pos) const {
+    Key key;
+    std::memcpy(&key, keys_ + pos * sizeof(Key), sizeof(Key));
+    return key;
+  }
+
+  std::string_view BytesAt(size_t pos) const {
+    return std::string_view(blob_ + key_offsets_[pos], key_offsets_[pos + 1] - key_offsets_[pos]);
+  }
+
+  bool KeyEquals(size_t pos, const ValueType &value) const {
+    if constexpr (kKind == mapped_detail::KeyKind::kTrivial) {
+      return equal_(KeyAt(pos), value);
+    } else {
+      return BytesAt(pos) == static_cast<std::string_view>(value);
+    }
+  }
+};
+
+#endif  // UNORDERED_SET_MAPPED_UNORDERED_SET_H
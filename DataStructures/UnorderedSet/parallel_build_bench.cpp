@@ -0,0 +1,64 @@
+// Build time of UnorderedSet from a vector of keys: a sequential Insert loop versus InsertParallel on 1..N threads.
+// Some keys repeat, so the build also deduplicates. On a single core the threaded runs show only the overhead.
+//   g++ -std=c++17 -O2 -pthread parallel_build_bench.cpp -o parallel_build_bench
+//   ./parallel_build_bench [n] [max_threads]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "unordered_set.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8000000;
+  size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+  if (argc > 2) {
+    max_threads = std::strtoull(argv[2], nullptr, 10);
+  }
+  std::mt19937_64 random(1);
+  std::vector<uint64_t> keys(n);
+  for (auto &key : keys) {
+    key = random() % (n * 9);
+  }
+
+  auto start = Clock::now();
+  UnorderedSet<uint64_t> sequential(n);
+  for (auto key : keys) {
+    sequential.Insert(key);
+  }
+  double baseline = Milliseconds(start);
+  std::printf("%zu keys, %zu unique\n", n, sequential.Size());
+  std::printf("%-12s %10s %8s\n", "build", "ms", "speedup");
+  std::printf("%-12s %10.1f %8.2f\n", "Insert loop", baseline, 1.0);
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    start = Clock::now();
+    UnorderedSet<uint64_t> parallel(n);
+    parallel.InsertParallel(keys.begin(), keys.end(), threads);
+    double elapsed = Milliseconds(start);
+    if (parallel.Size() != sequential.Size()) {
+      std::printf("size mismatch: %zu vs %zu\n", parallel.Size(), sequential.Size());
+      return 1;
+    }
+    std::printf("%2zu threads   %10.1f %8.2f\n", threads, elapsed, baseline / elapsed);
+  }
+
+  start = Clock::now();
+  UnorderedSet<uint64_t> constructed(keys.begin(), keys.end());
+  double elapsed = Milliseconds(start);
+  std::printf("%-12s %10.1f %8.2f\n", "range ctor", elapsed, baseline / elapsed);
+}
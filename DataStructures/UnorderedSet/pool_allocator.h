@@ -0,0 +1,168 @@
+#ifndef UNORDERED_SET_POOL_ALLOCATOR_H
+#define UNORDERED_SET_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class NodePool {
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  static constexpr size_t kFirstChunkBlocks = 64;
+  static constexpr size_t kMaxChunkBlocks = 4096;
+
+  std::vector<void *> chunks_;
+  FreeBlock *free_list_{};
+  char *cursor_{};
+  char *chunk_end_{};
+  size_t block_size_{};
+  size_t chunk_blocks_{kFirstChunkBlocks};
+  size_t n_live_{};
+
+  static size_t RoundBlockSize(size_t size) {
+    constexpr size_t kAlign = alignof(std::max_align_t);
+    size = size < sizeof(FreeBlock) ? sizeof(FreeBlock) : size;
+    return (size + kAlign - 1) / kAlign * kAlign;
+  }
+
+  void AllocateChunk() {
+    chunks_.reserve(chunks_.size() + 1);
+    cursor_ = static_cast<char *>(operator new(block_size_ * chunk_blocks_));
+    chunks_.push_back(cursor_);
+    chunk_end_ = cursor_ + block_size_ * chunk_blocks_;
+    if (chunk_blocks_ < kMaxChunkBlocks) {
+      chunk_blocks_ *= 2;
+    }
+  }
+
+ public:
+  NodePool() = default;
+  NodePool(const NodePool &other) = delete;
+  NodePool &operator=(const NodePool &other) = delete;
+
+  ~NodePool() {
+    for (auto *chunk : chunks_) {
+      operator delete(chunk);
+    }
+  }
+
+  bool Owns(size_t size) const {
+    return block_size_ == 0 || RoundBlockSize(size) == block_size_;
+  }
+
+  void *Allocate(size_t size) {
+    if (block_size_ == 0) {
+      block_size_ = RoundBlockSize(size);
+    }
+    ++n_live_;
+    if (free_list_ != nullptr) {
+      return std::exchange(free_list_, free_list_->next);
+    }
+    if (cursor_ == chunk_end_) {
+      try {
+        AllocateChunk();
+      } catch (...) {
+        --n_live_;
+        throw;
+      }
+    }
+    return std::exchange(cursor_, cursor_ + block_size_);
+  }
+
+  void Deallocate(void *pointer) noexcept {
+    free_list_ = new (pointer) FreeBlock{free_list_};
+    --n_live_;
+  }
+
+  void ReleaseUnused() noexcept {
+    if (n_live_ != 0) {
+      return;
+    }
+    for (auto *chunk : chunks_) {
+      operator delete(chunk);
+    }
+    chunks_.clear();
+    free_list_ = nullptr;
+    cursor_ = chunk_end_ = nullptr;
+    chunk_blocks_ = kFirstChunkBlocks;
+  }
+
+  [[nodiscard]] size_t ChunkCount() const noexcept {
+    return chunks_.size();
+  }
+
+  [[nodiscard]] size_t LiveBlocks() const noexcept {
+    return n_live_;
+  }
+};
+
+template <class T>
+class PoolAllocator {
+ private:
+  std::shared_ptr<NodePool> pool_;
+
+  template <class U>
+  friend class PoolAllocator;
+
+ public:
+  using value_type = T;                                            // NOLINT
+  using propagate_on_container_copy_assignment = std::false_type;  // NOLINT
+  using propagate_on_container_move_assignment = std::true_type;   // NOLINT
+  using propagate_on_container_swap = std::true_type;              // NOLINT
+  using is_always_equal = std::false_type;                         // NOLINT
+
+  PoolAllocator() : pool_(std::make_shared<NodePool>()) {
+  }
+
+  PoolAllocator(const PoolAllocator &other) noexcept = default;
+  PoolAllocator &operator=(const PoolAllocator &other) noexcept = default;
+
+  template <class U>
+  PoolAllocator(const PoolAllocator<U> &other) noexcept : pool_(other.pool_) {  // NOLINT
+  }
+
+  T *allocate(size_t count) {  // NOLINT
+    if (count == 1 && alignof(T) <= alignof(std::max_align_t) && pool_->Owns(sizeof(T))) {
+      return static_cast<T *>(pool_->Allocate(sizeof(T)));
+    }
+    return static_cast<T *>(operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T *pointer, size_t count) noexcept {  // NOLINT
+    if (count == 1 && alignof(T) <= alignof(std::max_align_t) && pool_->Owns(sizeof(T))) {
+      pool_->Deallocate(pointer);
+      return;
+    }
+    operator delete(pointer);
+  }
+
+  PoolAllocator select_on_container_copy_construction() const {  // NOLINT
+    return PoolAllocator();
+  }
+
+  void ReleaseUnused() noexcept {
+    pool_->ReleaseUnused();
+  }
+
+  [[nodiscard]] const NodePool &Pool() const noexcept {
+    return *pool_;
+  }
+
+  template <class U>
+  bool operator==(const PoolAllocator<U> &other) const noexcept {
+    return pool_ == other.pool_;
+  }
+
+  template <class U>
+  bool operator!=(const PoolAllocator<U> &other) const noexcept {
+    return pool_ != other.pool_;
+  }
+};
+
+#endif  // UNORDERED_SET_POOL_ALLOCATOR_H
@@ -0,0 +1,86 @@
+// UnorderedSet with std::allocator and with PoolAllocator: heap allocation count and time for n inserts,
+// for erasing and re-inserting every key, and for Clear. Allocations are counted by replacing the global
+// operator new, which both std::allocator and the pool chunks go through.
+//   g++ -std=c++17 -O2 pool_allocator_bench.cpp -o pool_allocator_bench && ./pool_allocator_bench [n]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "pool_allocator.h"
+#include "unordered_set.h"
+
+namespace {
+
+size_t n_allocations = 0;
+
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <class Set>
+void Run(const char *name, const std::vector<uint64_t> &keys) {
+  Set set;
+  size_t allocations_before = n_allocations;
+  auto start = Clock::now();
+  for (auto key : keys) {
+    set.Insert(key);
+  }
+  double insert_ms = Milliseconds(start);
+  size_t insert_allocations = n_allocations - allocations_before;
+
+  allocations_before = n_allocations;
+  start = Clock::now();
+  for (auto key : keys) {
+    set.Erase(key);
+  }
+  for (auto key : keys) {
+    set.Insert(key);
+  }
+  double churn_ms = Milliseconds(start);
+  size_t churn_allocations = n_allocations - allocations_before;
+
+  start = Clock::now();
+  set.Clear();
+  double clear_ms = Milliseconds(start);
+  std::printf("%-16s %10.1f %12zu %10.1f %12zu %10.1f\n", name, insert_ms, insert_allocations, churn_ms,
+              churn_allocations, clear_ms);
+}
+
+}  // namespace
+
+void *operator new(size_t size) {
+  ++n_allocations;
+  if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+  std::mt19937_64 random(1);
+  std::vector<uint64_t> keys(n);
+  for (auto &key : keys) {
+    key = random();
+  }
+  std::printf("%zu keys\n", n);
+  std::printf("%-16s %10s %12s %10s %12s %10s\n", "allocator", "insert_ms", "insert_news", "churn_ms", "churn_news",
+              "clear_ms");
+  Run<UnorderedSet<uint64_t>>("std::allocator", keys);
+  Run<UnorderedSet<uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>, ModuloBucketPolicy,
+                   PoolAllocator<uint64_t>>>("PoolAllocator", keys);
+}
@@ -0,0 +1,342 @@
+#ifndef UNORDERED_SET_RCU_UNORDERED_SET_H
+#define UNORDERED_SET_RCU_UNORDERED_SET_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "bucket_policy.h"
+
+namespace rcu_detail {
+
+inline constexpr size_t kSlotsPerBlock = 256;
+inline constexpr uint64_t kIdle = std::numeric_limits<uint64_t>::max();
+
+class EpochDomain {
+ private:
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> epoch{kIdle};
+    std::atomic<bool> used{false};
+  };
+
+  struct SlotBlock {
+    Slot slots[kSlotsPerBlock];
+    std::atomic<SlotBlock *> next{nullptr};
+  };
+
+  struct ThreadSlot {
+    Slot *slot{};
+    size_t depth{};
+
+    ~ThreadSlot() {
+      if (slot != nullptr) {
+        slot->used.store(false, std::memory_order_release);
+      }
+    }
+  };
+
+  alignas(64) std::atomic<uint64_t> global_epoch_{0};
+  SlotBlock head_;
+
+  static ThreadSlot &CurrentThreadSlot() {
+    thread_local ThreadSlot thread_slot;
+    return thread_slot;
+  }
+
+  Slot *AcquireSlot() {
+    SlotBlock *block = &head_;
+    while (true) {
+      for (auto &slot : block->slots) {
+        bool expected = false;
+        if (!slot.used.load(std::memory_order_relaxed) &&
+            slot.used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+          return &slot;
+        }
+      }
+      SlotBlock *next = block->next.load(std::memory_order_acquire);
+      if (next == nullptr) {
+        auto fresh = std::make_unique<SlotBlock>();
+        fresh->slots[0].used.store(true, std::memory_order_relaxed);
+        if (block->next.compare_exchange_strong(next, fresh.get(), std::memory_order_acq_rel)) {
+          return &fresh.release()->slots[0];
+        }
+      }
+      block = next;
+    }
+  }
+
+ public:
+  EpochDomain() = default;
+
+  EpochDomain(const EpochDomain &other) = delete;
+  EpochDomain &operator=(const EpochDomain &other) = delete;
+
+  ~EpochDomain() {
+    SlotBlock *block = head_.next.load(std::memory_order_acquire);
+    while (block != nullptr) {
+      delete std::exchange(block, block->next.load(std::memory_order_relaxed));
+    }
+  }
+
+  static EpochDomain &Instance() {
+    static EpochDomain domain;
+    return domain;
+  }
+
+  void Enter() {
+    auto &thread_slot = CurrentThreadSlot();
+    if (thread_slot.depth++ > 0) {
+      return;
+    }
+    if (thread_slot.slot == nullptr) {
+      thread_slot.slot = AcquireSlot();
+    }
+    thread_slot.slot->epoch.store(global_epoch_.load(std::memory_order_acquire), std::memory_order_seq_cst);
+  }
+
+  void Exit() {
+    auto &thread_slot = CurrentThreadSlot();
+    if (--thread_slot.depth > 0) {
+      return;
+    }
+    thread_slot.slot->epoch.store(kIdle, std::memory_order_release);
+  }
+
+  uint64_t Advance() {
+    return global_epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  }
+
+  uint64_t MinActiveEpoch() const {
+    uint64_t min_epoch = kIdle;
+    for (const SlotBlock *block = &head_; block != nullptr; block = block->next.load(std::memory_order_acquire)) {
+      for (auto &slot : block->slots) {
+        min_epoch = std::min(min_epoch, slot.epoch.load(std::memory_order_seq_cst));
+      }
+    }
+    return min_epoch;
+  }
+};
+
+class ReadGuard {
+ public:
+  ReadGuard() {
+    EpochDomain::Instance().Enter();
+  }
+
+  ReadGuard(const ReadGuard &other) = delete;
+  ReadGuard &operator=(const ReadGuard &other) = delete;
+
+  ~ReadGuard() {
+    EpochDomain::Instance().Exit();
+  }
+};
+
+}  // namespace rcu_detail
+
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class BucketPolicy = ModuloBucketPolicy>
+class RcuUnorderedSet {
+ private:
+  struct Node {
+    Key key;
+    size_t hash;
+    std::atomic<Node *> next;
+
+    Node(const Key &node_key, size_t node_hash, Node *node_next) : key(node_key), hash(node_hash), next(node_next) {
+    }
+  };
+
+  struct Table {
+    size_t n_bucket;
+    std::unique_ptr<std::atomic<Node *>[]> buckets;
+
+    explicit Table(size_t count) : n_bucket(count), buckets(std::make_unique<std::atomic<Node *>[]>(count)) {
+      for (size_t i = 0; i < n_bucket; ++i) {
+        buckets[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    ~Table() {
+      for (size_t i = 0; i < n_bucket; ++i) {
+        Node *node = buckets[i].load(std::memory_order_relaxed);
+        while (node != nullptr) {
+          delete std::exchange(node, node->next.load(std::memory_order_relaxed));
+        }
+      }
+    }
+  };
+
+  struct Retired {
+    void *pointer;
+    void (*deleter)(void *);
+    uint64_t epoch;
+  };
+
+  static constexpr size_t kReclaimThreshold = 64;
+
+  std::atomic<Table *> table_{};
+  std::atomic<size_t> n_elements_{};
+  std::mutex write_mutex_;
+  std::vector<Retired> retired_;
+  Hash hash_{};
+  KeyEqual equal_{};
+
+ public:
+  using ValueType = Key;
+  using SizeType = size_t;
+  using Hasher = Hash;
+
+ public:
+  explicit RcuUnorderedSet(size_t count = 1, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+      : hash_(hash), equal_(equal) {
+    table_.store(new Table(std::max<size_t>(1, BucketPolicy::BucketCount(count))), std::memory_order_relaxed);
+  }
+
+  RcuUnorderedSet(const RcuUnorderedSet &other) = delete;
+  RcuUnorderedSet &operator=(const RcuUnorderedSet &other) = delete;
+
+  // Frees the current table and everything still retired without waiting for readers: no thread may be
+  // inside Find, ForEach or BucketCount of this set when it is destroyed.
+  ~RcuUnorderedSet() {
+    delete table_.load(std::memory_order_relaxed);
+    for (auto &retired : retired_) {
+      retired.deleter(retired.pointer);
+    }
+  }
+
+  [[nodiscard]] bool Find(const ValueType &value) const {
+    rcu_detail::ReadGuard guard;
+    const Table *table = table_.load(std::memory_order_seq_cst);
+    auto hash = hash_(value);
+    Node *node = table->buckets[BucketPolicy::Index(hash, table->n_bucket)].load(std::memory_order_seq_cst);
+    for (; node != nullptr; node = node->next.load(std::memory_order_seq_cst)) {
+      if (node->hash == hash && equal_(node->key, value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class Function>
+  void ForEach(Function function) const {
+    rcu_detail::ReadGuard guard;
+    const Table *table = table_.load(std::memory_order_seq_cst);
+    for (size_t i = 0; i < table->n_bucket; ++i) {
+      Node *node = table->buckets[i].load(std::memory_order_seq_cst);
+      for (; node != nullptr; node = node->next.load(std::memory_order_seq_cst)) {
+        function(node->key);
+      }
+    }
+  }
+
+  bool Insert(const ValueType &insert_value) {
+    std::lock_guard lock(write_mutex_);
+    Table *table = table_.load(std::memory_order_relaxed);
+    auto hash = hash_(insert_value);
+    if (FindNode(table, hash, insert_value).second != nullptr) {
+      return false;
+    }
+    if (n_elements_.load(std::memory_order_relaxed) >= table->n_bucket) {
+      table = Grow(table);
+    }
+    auto &bucket = table->buckets[BucketPolicy::Index(hash, table->n_bucket)];
+    bucket.store(new Node(insert_value, hash, bucket.load(std::memory_order_relaxed)), std::memory_order_release);
+    n_elements_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  size_t Erase(const ValueType &erase_value) {
+    std::lock_guard lock(write_mutex_);
+    Table *table = table_.load(std::memory_order_relaxed);
+    auto [link, node] = FindNode(table, hash_(erase_value), erase_value);
+    if (node == nullptr) {
+      return 0;
+    }
+    link->store(node->next.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+    n_elements_.fetch_sub(1, std::memory_order_relaxed);
+    Retire(node, [](void *pointer) { delete static_cast<Node *>(pointer); });
+    return 1;
+  }
+
+  void Clear() {
+    std::lock_guard lock(write_mutex_);
+    Table *old_table = table_.exchange(new Table(1), std::memory_order_seq_cst);
+    n_elements_.store(0, std::memory_order_relaxed);
+    Retire(old_table, [](void *pointer) { delete static_cast<Table *>(pointer); });
+  }
+
+  void Synchronize() {
+    std::lock_guard lock(write_mutex_);
+    Reclaim();
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return n_elements_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return Size() == 0;
+  }
+
+  [[nodiscard]] SizeType BucketCount() const {
+    rcu_detail::ReadGuard guard;
+    return table_.load(std::memory_order_seq_cst)->n_bucket;
+  }
+
+ private:
+  std::pair<std::atomic<Node *> *, Node *> FindNode(Table *table, size_t hash, const ValueType &value) const {
+    std::atomic<Node *> *link = &table->buckets[BucketPolicy::Index(hash, table->n_bucket)];
+    for (Node *node = link->load(std::memory_order_relaxed); node != nullptr;
+         node = node->next.load(std::memory_order_relaxed)) {
+      if (node->hash == hash && equal_(node->key, value)) {
+        return std::make_pair(link, node);
+      }
+      link = &node->next;
+    }
+    return std::make_pair(link, nullptr);
+  }
+
+  Table *Grow(Table *old_table) {
+    auto new_table = std::make_unique<Table>(BucketPolicy::BucketCount(2 * old_table->n_bucket));
+    for (size_t i = 0; i < old_table->n_bucket; ++i) {
+      Node *node = old_table->buckets[i].load(std::memory_order_relaxed);
+      for (; node != nullptr; node = node->next.load(std::memory_order_relaxed)) {
+        auto &bucket = new_table->buckets[BucketPolicy::Index(node->hash, new_table->n_bucket)];
+        bucket.store(new Node(node->key, node->hash, bucket.load(std::memory_order_relaxed)),
+                     std::memory_order_relaxed);
+      }
+    }
+    Table *table = new_table.release();
+    table_.store(table, std::memory_order_seq_cst);
+    Retire(old_table, [](void *pointer) { delete static_cast<Table *>(pointer); });
+    return table;
+  }
+
+  void Retire(void *pointer, void (*deleter)(void *)) {
+    retired_.push_back(Retired{pointer, deleter, rcu_detail::EpochDomain::Instance().Advance()});
+    if (retired_.size() >= kReclaimThreshold) {
+      Reclaim();
+    }
+  }
+
+  void Reclaim() {
+    uint64_t min_epoch = rcu_detail::EpochDomain::Instance().MinActiveEpoch();
+    size_t kept = 0;
+    for (auto &retired : retired_) {
+      if (retired.epoch <= min_epoch) {
+        retired.deleter(retired.pointer);
+      } else {
+        retired_[kept++] = retired;
+      }
+    }
+    retired_.resize(kept);
+  }
+};
+
+#endif  // UNORDERED_SET_RCU_UNORDERED_SET_H
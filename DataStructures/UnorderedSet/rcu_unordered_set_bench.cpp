@@ -0,0 +1,93 @@
+// Read scaling of RcuUnorderedSet against UnorderedSet behind a std::shared_mutex, at 1, 2, 4, 8 and 16 threads.
+// Each thread runs 99% Find and 1% Insert/Erase on random keys; the table reports Mops/s over all threads.
+//   g++ -std=c++17 -O2 -pthread rcu_unordered_set_bench.cpp -o rcu_bench && ./rcu_bench [ops]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "rcu_unordered_set.h"
+#include "unordered_set.h"
+
+namespace {
+
+constexpr uint64_t kKeyRange = 1 << 18;
+
+class SharedLockedSet {
+ private:
+  mutable std::shared_mutex mutex_;
+  UnorderedSet<uint64_t> set_;
+
+ public:
+  bool Insert(uint64_t key) {
+    std::unique_lock lock(mutex_);
+    return set_.Insert(key).second;
+  }
+
+  size_t Erase(uint64_t key) {
+    std::unique_lock lock(mutex_);
+    return set_.Erase(key);
+  }
+
+  bool Find(uint64_t key) const {
+    std::shared_lock lock(mutex_);
+    return set_.Find(key);
+  }
+};
+
+template <class Set>
+double OpsPerSecond(Set &set, size_t n_threads, size_t ops_per_thread) {
+  std::vector<std::thread> threads;
+  std::vector<size_t> found(n_threads);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t] {
+      std::mt19937_64 random(t + 1);
+      for (size_t i = 0; i < ops_per_thread; ++i) {
+        uint64_t value = random();
+        uint64_t key = value % kKeyRange;
+        if (value >> 57 == 0) {
+          set.Insert(key);
+        } else if (value >> 57 == 1) {
+          set.Erase(key);
+        } else {
+          found[t] += set.Find(key) ? 1 : 0;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return static_cast<double>(n_threads * ops_per_thread) / seconds;
+}
+
+template <class Set>
+void Prefill(Set &set) {
+  for (uint64_t key = 0; key < kKeyRange; key += 2) {
+    set.Insert(key);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  size_t total_ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16000000;
+  std::printf("%zu ops per run, %u hardware threads\n", total_ops, std::thread::hardware_concurrency());
+  std::printf("%8s %20s %12s\n", "threads", "shared_mutex Mops/s", "rcu Mops/s");
+  for (size_t n_threads : {1, 2, 4, 8, 16}) {
+    SharedLockedSet locked;
+    Prefill(locked);
+    RcuUnorderedSet<uint64_t> rcu(kKeyRange);
+    Prefill(rcu);
+    double locked_ops = OpsPerSecond(locked, n_threads, total_ops / n_threads);
+    double rcu_ops = OpsPerSecond(rcu, n_threads, total_ops / n_threads);
+    std::printf("%8zu %20.2f %12.2f\n", n_threads, locked_ops / 1e6, rcu_ops / 1e6);
+  }
+}
@@ -0,0 +1,102 @@
+// Stress test for RcuUnorderedSet: lock-free readers against a writer that keeps inserting, erasing and growing.
+// Build with ThreadSanitizer to check the epoch reclamation:
+//   g++ -std=c++17 -O1 -g -fsanitize=thread rcu_unordered_set_test.cpp -o rcu_test && ./rcu_test
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rcu_unordered_set.h"
+
+namespace {
+
+constexpr int kKeys = 1000;
+constexpr int kReaders = 6;
+constexpr int kRounds = 200;
+
+void ReadersAgainstWriter() {
+  RcuUnorderedSet<std::string> set;
+  for (int i = 0; i < kKeys; i += 2) {
+    set.Insert(std::to_string(i));
+  }
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < kReaders; ++t) {
+    readers.emplace_back([&] {
+      while (!stop.load()) {
+        for (int i = 0; i < kKeys; i += 2) {
+          assert(set.Find(std::to_string(i)));
+        }
+        size_t even = 0;
+        set.ForEach([&](const std::string &key) { even += (std::stoi(key) % 2 == 0); });
+        assert(even == kKeys / 2);
+      }
+    });
+  }
+
+  std::thread writer([&] {
+    for (int round = 0; round < kRounds; ++round) {
+      for (int i = 1; i < kKeys; i += 2) {
+        set.Insert(std::to_string(i));
+      }
+      for (int i = 1; i < kKeys; i += 2) {
+        set.Erase(std::to_string(i));
+      }
+      if (round % 50 == 0) {
+        set.Synchronize();
+      }
+    }
+    stop = true;
+  });
+
+  writer.join();
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  assert(set.Size() == kKeys / 2);
+  for (int i = 0; i < kKeys; ++i) {
+    assert(set.Find(std::to_string(i)) == (i % 2 == 0));
+  }
+  set.Clear();
+  assert(set.Empty());
+}
+
+void MoreReadersThanSlotsPerBlock() {
+  RcuUnorderedSet<int> set;
+  set.Insert(1);
+
+  constexpr size_t kThreads = rcu_detail::kSlotsPerBlock + 44;
+  std::mutex mutex;
+  std::condition_variable all_read;
+  size_t done = 0;
+  std::vector<std::thread> readers;
+  for (size_t t = 0; t < kThreads; ++t) {
+    readers.emplace_back([&] {
+      assert(set.Find(1));
+      std::unique_lock lock(mutex);
+      if (++done == kThreads) {
+        all_read.notify_all();
+      }
+      all_read.wait(lock, [&] { return done == kThreads; });
+    });
+  }
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  set.Erase(1);
+  set.Synchronize();
+  assert(!set.Find(1));
+}
+
+}  // namespace
+
+int main() {
+  ReadersAgainstWriter();
+  MoreReadersThanSlotsPerBlock();
+}
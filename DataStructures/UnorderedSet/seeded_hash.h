@@ -0,0 +1,91 @@
+#ifndef UNORDERED_SET_SEEDED_HASH_H
+#define UNORDERED_SET_SEEDED_HASH_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string_view>
+#include <type_traits>
+
+namespace seeded_hash_detail {
+
+inline uint64_t Rotl(uint64_t value, int shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline void SipRound(uint64_t &v0, uint64_t &v1, uint64_t &v2, uint64_t &v3) {
+  v0 += v1;
+  v1 = Rotl(v1, 13) ^ v0;
+  v0 = Rotl(v0, 32);
+  v2 += v3;
+  v3 = Rotl(v3, 16) ^ v2;
+  v0 += v3;
+  v3 = Rotl(v3, 21) ^ v0;
+  v2 += v1;
+  v1 = Rotl(v1, 17) ^ v2;
+  v2 = Rotl(v2, 32);
+}
+
+inline uint64_t SipHash13(const void *data, size_t size, uint64_t key0, uint64_t key1) {
+  uint64_t v0 = key0 ^ 0x736f6d6570736575ULL;
+  uint64_t v1 = key1 ^ 0x646f72616e646f6dULL;
+  uint64_t v2 = key0 ^ 0x6c7967656e657261ULL;
+  uint64_t v3 = key1 ^ 0x7465646279746573ULL;
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  size_t full = size / 8 * 8;
+  for (size_t i = 0; i < full; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, 8);
+    v3 ^= word;
+    SipRound(v0, v1, v2, v3);
+    v0 ^= word;
+  }
+  uint64_t last = static_cast<uint64_t>(size) << 56;
+  for (size_t i = full; i < size; ++i) {
+    last |= static_cast<uint64_t>(bytes[i]) << (8 * (i - full));
+  }
+  v3 ^= last;
+  SipRound(v0, v1, v2, v3);
+  v0 ^= last;
+  v2 ^= 0xff;
+  for (int round = 0; round < 3; ++round) {
+    SipRound(v0, v1, v2, v3);
+  }
+  return v0 ^ v1 ^ v2 ^ v3;
+}
+
+inline uint64_t RandomSeed() {
+  std::random_device device;
+  return (static_cast<uint64_t>(device()) << 32) ^ device();
+}
+
+}  // namespace seeded_hash_detail
+
+template <class Key, class Hash = std::hash<Key>>
+class SeededHash {
+ private:
+  Hash hash_{};
+  uint64_t seed0_;
+  uint64_t seed1_;
+
+ public:
+  explicit SeededHash(const Hash &hash = Hash())
+      : hash_(hash), seed0_(seeded_hash_detail::RandomSeed()), seed1_(seeded_hash_detail::RandomSeed()) {
+  }
+
+  SeededHash(uint64_t seed0, uint64_t seed1, const Hash &hash = Hash()) : hash_(hash), seed0_(seed0), seed1_(seed1) {
+  }
+
+  size_t operator()(const Key &key) const {
+    if constexpr (std::is_convertible_v<const Key &, std::string_view>) {
+      std::string_view bytes = key;
+      return seeded_hash_detail::SipHash13(bytes.data(), bytes.size(), seed0_, seed1_);
+    } else {
+      uint64_t value = hash_(key);
+      return seeded_hash_detail::SipHash13(&value, sizeof(value), seed0_, seed1_);
+    }
+  }
+};
+
+#endif  // UNORDERED_SET_SEEDED_HASH_H
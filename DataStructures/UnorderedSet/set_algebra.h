@@ -0,0 +1,162 @@
+#ifndef UNORDERED_SET_SET_ALGEBRA_H
+#define UNORDERED_SET_SET_ALGEBRA_H
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "unordered_set.h"
+
+namespace set_algebra_detail {
+
+inline constexpr size_t kBatchSize = 16;
+
+template <class Key>
+struct Hashed {
+  const Key *key;
+  size_t hash;
+};
+
+template <class Set>
+constexpr bool kReuseHash = std::is_empty_v<typename Set::Hasher>;
+
+template <class Set>
+size_t HashFor(const Set &target, const typename Set::ValueType &key, size_t source_hash) {
+  if constexpr (kReuseHash<Set>) {
+    return source_hash;
+  } else {
+    return target.HashOf(key);
+  }
+}
+
+template <class Set>
+void SelectPart(const Set &source, const Set &probe, bool keep_found, size_t part, size_t n_parts,
+                std::vector<Hashed<typename Set::ValueType>> &selected) {
+  using Key = typename Set::ValueType;
+  size_t hashes[kBatchSize];
+  const Key *keys[kBatchSize];
+  size_t source_hashes[kBatchSize];
+  bool found[kBatchSize];
+  size_t batch = 0;
+  auto flush = [&] {
+    probe.FindBatchWithHash(hashes, keys, batch, found);
+    for (size_t i = 0; i < batch; ++i) {
+      if (found[i] == keep_found) {
+        selected.push_back(Hashed<Key>{keys[i], source_hashes[i]});
+      }
+    }
+    batch = 0;
+  };
+  source.ForEachWithHash(part, n_parts, [&](const Key &key, size_t hash) {
+    keys[batch] = &key;
+    source_hashes[batch] = hash;
+    hashes[batch] = HashFor(probe, key, hash);
+    if (++batch == kBatchSize) {
+      flush();
+    }
+  });
+  flush();
+}
+
+template <class Set>
+std::vector<Hashed<typename Set::ValueType>> Select(const Set &source, const Set &probe, bool keep_found,
+                                                    size_t n_threads) {
+  std::vector<Hashed<typename Set::ValueType>> selected;
+  if (n_threads <= 1 || source.Size() < n_threads * kBatchSize) {
+    SelectPart(source, probe, keep_found, 0, 1, selected);
+    return selected;
+  }
+  std::vector<std::vector<Hashed<typename Set::ValueType>>> parts(n_threads);
+  unordered_set_detail::RunParallel(
+      n_threads, [&](size_t part) { SelectPart(source, probe, keep_found, part, n_threads, parts[part]); });
+  for (auto &part : parts) {
+    selected.insert(selected.end(), part.begin(), part.end());
+  }
+  return selected;
+}
+
+template <class Set>
+Set Collect(const Set &model, const std::vector<Hashed<typename Set::ValueType>> &selected) {
+  Set result(selected.size(), model.HashFunction(), model.KeyEq(), model.GetAllocator());
+  for (auto &item : selected) {
+    result.InsertWithHash(HashFor(result, *item.key, item.hash), *item.key);
+  }
+  return result;
+}
+
+}  // namespace set_algebra_detail
+
+template <class Key, class Hash, class KeyEqual, class BucketPolicy, class Allocator>
+UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> Union(
+    const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &first,
+    const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &second) {
+  const auto &larger = first.Size() >= second.Size() ? first : second;
+  const auto &smaller = first.Size() >= second.Size() ? second : first;
+  auto result = larger;
+  result.Reserve(larger.Size() + smaller.Size());
+  smaller.ForEachWithHash(
+      [&](const Key &key, size_t hash) { result.InsertWithHash(set_algebra_detail::HashFor(result, key, hash), key); });
+  return result;
+}
+
+template <class Key, class Hash, class KeyEqual, class BucketPolicy, class Allocator>
+UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> Intersect(
+    const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &first,
+    const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &second, size_t n_threads = 1) {
+  const auto &larger = first.Size() >= second.Size() ? first : second;
+  const auto &smaller = first.Size() >= second.Size() ? second : first;
+  return set_algebra_detail::Collect(first, set_algebra_detail::Select(smaller, larger, true, n_threads));
+}
+
+template <class Key, class Hash, class KeyEqual, class BucketPolicy, class Allocator>
+UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> Difference(
+    const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &first,
+    const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &second, size_t n_threads = 1) {
+  return set_algebra_detail::Collect(first, set_algebra_detail::Select(first, second, false, n_threads));
+}
+
+template <class Key, class Hash, class KeyEqual, class BucketPolicy, class Allocator>
+void UnionInPlace(UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &first,
+                  const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &second) {
+  if (&first == &second) {
+    return;
+  }
+  first.Reserve(first.Size() + second.Size());
+  second.ForEachWithHash(
+      [&](const Key &key, size_t hash) { first.InsertWithHash(set_algebra_detail::HashFor(first, key, hash), key); });
+}
+
+template <class Key, class Hash, class KeyEqual, class BucketPolicy, class Allocator>
+void IntersectInPlace(UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &first,
+                      const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &second, size_t n_threads = 1) {
+  if (&first == &second) {
+    return;
+  }
+  if (second.Size() < first.Size() / 2) {
+    first = Intersect(first, second, n_threads);
+    return;
+  }
+  for (auto &item : set_algebra_detail::Select(first, second, false, n_threads)) {
+    first.EraseWithHash(item.hash, *item.key);
+  }
+}
+
+template <class Key, class Hash, class KeyEqual, class BucketPolicy, class Allocator>
+void DifferenceInPlace(UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &first,
+                       const UnorderedSet<Key, Hash, KeyEqual, BucketPolicy, Allocator> &second, size_t n_threads = 1) {
+  if (&first == &second) {
+    first.Clear();
+    return;
+  }
+  if (second.Size() <= first.Size()) {
+    second.ForEachWithHash(
+        [&](const Key &key, size_t hash) { first.EraseWithHash(set_algebra_detail::HashFor(first, key, hash), key); });
+    return;
+  }
+  for (auto &item : set_algebra_detail::Select(first, second, true, n_threads)) {
+    first.EraseWithHash(item.hash, *item.key);
+  }
+}
+
+#endif  // UNORDERED_SET_SET_ALGEBRA_H
@@ -0,0 +1,105 @@
+#ifndef UNORDERED_SET_TABLE_STATS_H
+#define UNORDERED_SET_TABLE_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct StatsSnapshot {
+  size_t finds{};
+  size_t hits{};
+  size_t probes{};
+  size_t max_probe{};
+  size_t rehashes{};
+  std::chrono::nanoseconds rehash_time{};
+  size_t bytes{};
+  std::vector<size_t> chain_histogram{};
+
+  [[nodiscard]] double HitRatio() const {
+    return finds == 0 ? 0 : static_cast<double>(hits) / finds;
+  }
+
+  [[nodiscard]] double AverageProbe() const {
+    return finds == 0 ? 0 : static_cast<double>(probes) / finds;
+  }
+
+  void Dump(std::ostream &os, const std::string &prefix = "unordered_set") const {
+    os << prefix << ".finds " << finds << '\n';
+    os << prefix << ".hits " << hits << '\n';
+    os << prefix << ".misses " << finds - hits << '\n';
+    os << prefix << ".hit_ratio " << HitRatio() << '\n';
+    os << prefix << ".probe_avg " << AverageProbe() << '\n';
+    os << prefix << ".probe_max " << max_probe << '\n';
+    os << prefix << ".rehashes " << rehashes << '\n';
+    os << prefix << ".rehash_ns " << rehash_time.count() << '\n';
+    os << prefix << ".bytes " << bytes << '\n';
+    for (size_t length = 0; length < chain_histogram.size(); ++length) {
+      os << prefix << ".chain_length{" << length << "} " << chain_histogram[length] << '\n';
+    }
+  }
+};
+
+class TableStats {
+ private:
+  mutable std::atomic<size_t> finds_{};
+  mutable std::atomic<size_t> hits_{};
+  mutable std::atomic<size_t> probes_{};
+  mutable std::atomic<size_t> max_probe_{};
+  std::atomic<size_t> rehashes_{};
+  std::atomic<int64_t> rehash_nanoseconds_{};
+
+ public:
+  class RehashTimer {
+   private:
+    TableStats &stats_;
+    size_t rehashes_;
+    std::chrono::steady_clock::time_point start_;
+
+   public:
+    // Migration steps of an incremental rehash pass rehashes = 0: their time belongs to the rehash that started them.
+    explicit RehashTimer(TableStats &stats, size_t rehashes = 1)
+        : stats_(stats), rehashes_(rehashes), start_(std::chrono::steady_clock::now()) {
+    }
+
+    RehashTimer(const RehashTimer &other) = delete;
+    RehashTimer &operator=(const RehashTimer &other) = delete;
+
+    ~RehashTimer() {
+      auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+      stats_.rehashes_.fetch_add(rehashes_, std::memory_order_relaxed);
+      stats_.rehash_nanoseconds_.fetch_add(elapsed.count(), std::memory_order_relaxed);
+    }
+  };
+
+  void RecordFind(bool found, size_t probes) const {
+    finds_.fetch_add(1, std::memory_order_relaxed);
+    hits_.fetch_add(found ? 1 : 0, std::memory_order_relaxed);
+    probes_.fetch_add(probes, std::memory_order_relaxed);
+    size_t max_probe = max_probe_.load(std::memory_order_relaxed);
+    while (probes > max_probe && !max_probe_.compare_exchange_weak(max_probe, probes, std::memory_order_relaxed)) {
+    }
+  }
+
+  void Reset() {
+    finds_.store(0, std::memory_order_relaxed);
+    hits_.store(0, std::memory_order_relaxed);
+    probes_.store(0, std::memory_order_relaxed);
+    max_probe_.store(0, std::memory_order_relaxed);
+    rehashes_.store(0, std::memory_order_relaxed);
+    rehash_nanoseconds_.store(0, std::memory_order_relaxed);
+  }
+
+  void Fill(StatsSnapshot &snapshot) const {
+    snapshot.finds = finds_.load(std::memory_order_relaxed);
+    snapshot.hits = hits_.load(std::memory_order_relaxed);
+    snapshot.probes = probes_.load(std::memory_order_relaxed);
+    snapshot.max_probe = max_probe_.load(std::memory_order_relaxed);
+    snapshot.rehashes = rehashes_.load(std::memory_order_relaxed);
+    snapshot.rehash_time = std::chrono::nanoseconds(rehash_nanoseconds_.load(std::memory_order_relaxed));
+  }
+};
+
+#endif  // UNORDERED_SET_TABLE_STATS_H
@@ -0,0 +1,178 @@
+#ifndef UNORDERED_SET_UNORDERED_MAP_H
+#define UNORDERED_SET_UNORDERED_MAP_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "unordered_set.h"
+
+namespace unordered_map_detail {
+
+template <class Key, class Value, class Hash>
+struct EntryHash {
+  using is_transparent = void;
+
+  Hash hash;
+
+  size_t operator()(const std::pair<const Key, Value> &entry) const {
+    return hash(entry.first);
+  }
+
+  size_t operator()(const Key &key) const {
+    return hash(key);
+  }
+};
+
+template <class Key, class Value, class KeyEqual>
+struct EntryEqual {
+  using is_transparent = void;
+
+  KeyEqual equal;
+
+  bool operator()(const std::pair<const Key, Value> &lhs, const std::pair<const Key, Value> &rhs) const {
+    return equal(lhs.first, rhs.first);
+  }
+
+  bool operator()(const std::pair<const Key, Value> &lhs, const Key &rhs) const {
+    return equal(lhs.first, rhs);
+  }
+};
+
+}  // namespace unordered_map_detail
+
+template <class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class BucketPolicy = ModuloBucketPolicy, class Allocator = std::allocator<std::pair<const Key, Value>>>
+class UnorderedMap {
+ private:
+  using Entry = std::pair<const Key, Value>;
+  using Table = UnorderedSet<Entry, unordered_map_detail::EntryHash<Key, Value, Hash>,
+                             unordered_map_detail::EntryEqual<Key, Value, KeyEqual>, BucketPolicy, Allocator>;
+
+  Table table_{};
+
+ public:
+  using KeyType = Key;
+  using MappedType = Value;
+  using ValueType = Entry;
+  using SizeType = size_t;
+  using Hasher = Hash;
+  using KeyEqualType = KeyEqual;
+  using AllocatorType = Allocator;
+  using IteratorMap = typename Table::IteratorSet;
+
+ public:
+  UnorderedMap() = default;
+
+  explicit UnorderedMap(size_t count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+                        const Allocator &alloc = Allocator())
+      : table_(count, {hash}, {equal}, alloc) {
+  }
+
+  template <class... Args>
+  std::pair<IteratorMap, bool> TryEmplace(const Key &key, Args &&...args) {
+    return table_.EmplaceWithHash(table_.HashOf(key), key, std::piecewise_construct, std::forward_as_tuple(key),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <class... Args>
+  std::pair<IteratorMap, bool> TryEmplace(Key &&key, Args &&...args) {
+    return table_.EmplaceWithHash(table_.HashOf(key), key, std::piecewise_construct,
+                                  std::forward_as_tuple(std::move(key)),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <class M>
+  std::pair<IteratorMap, bool> InsertOrAssign(const Key &key, M &&value) {
+    auto pair = TryEmplace(key, std::forward<M>(value));
+    if (!pair.second) {
+      (*pair.first).second = std::forward<M>(value);
+    }
+    return pair;
+  }
+
+  template <class M>
+  std::pair<IteratorMap, bool> InsertOrAssign(Key &&key, M &&value) {
+    auto pair = TryEmplace(std::move(key), std::forward<M>(value));
+    if (!pair.second) {
+      (*pair.first).second = std::forward<M>(value);
+    }
+    return pair;
+  }
+
+  std::pair<IteratorMap, bool> Insert(const ValueType &entry) {
+    return table_.EmplaceWithHash(table_.HashOf(entry.first), entry.first, entry);
+  }
+
+  std::pair<IteratorMap, bool> Insert(ValueType &&entry) {
+    return table_.EmplaceWithHash(table_.HashOf(entry.first), entry.first, std::move(entry));
+  }
+
+  Value &operator[](const Key &key) {
+    return (*TryEmplace(key).first).second;
+  }
+
+  Value &operator[](Key &&key) {
+    return (*TryEmplace(std::move(key)).first).second;
+  }
+
+  Value &At(const Key &key) {
+    auto pair = table_.LocateWithHash(table_.HashOf(key), key);
+    if (!pair.second) {
+      throw std::out_of_range("UnorderedMap::At");
+    }
+    return (*pair.first).second;
+  }
+
+  [[nodiscard]] bool Find(const Key &key) const {
+    return table_.Find(key);
+  }
+
+  size_t Erase(const Key &key) {
+    return table_.EraseWithHash(table_.HashOf(key), key);
+  }
+
+  [[nodiscard]] SizeType Size() const noexcept {
+    return table_.Size();
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return table_.Empty();
+  }
+
+  void Clear() {
+    table_.Clear();
+  }
+
+  void Rehash(size_t new_bucket_count) {
+    table_.Rehash(new_bucket_count);
+  }
+
+  void Reserve(size_t new_bucket_count) {
+    table_.Reserve(new_bucket_count);
+  }
+
+  [[nodiscard]] SizeType BucketCount() const {
+    return table_.BucketCount();
+  }
+
+  [[nodiscard]] float LoadFactor() const {
+    return table_.LoadFactor();
+  }
+
+  [[nodiscard]] AllocatorType GetAllocator() const {
+    return table_.GetAllocator();
+  }
+
+  IteratorMap begin() {  // NOLINT
+    return table_.begin();
+  }
+
+  IteratorMap end() {  // NOLINT
+    return table_.end();
+  }
+};
+
+#endif  // UNORDERED_SET_UNORDERED_MAP_H
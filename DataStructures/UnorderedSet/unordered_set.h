@@ -8,20 +8,114 @@
 #include <exception>
 #include <vector>
 #include <list>
+#include <map>
+#include <set>
+#include <algorithm>
 #include <functional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "bucket_policy.h"
+#ifdef UNORDERED_SET_ENABLE_STATS
+#include "table_stats.h"
+#endif
+
+namespace unordered_set_detail {
+
+template <class T, class = void>
+struct IsTransparent : std::false_type {};
+
+template <class T>
+struct IsTransparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+template <class T, class = void>
+struct HasReleaseUnused : std::false_type {};
+
+template <class T>
+struct HasReleaseUnused<T, std::void_t<decltype(std::declval<T &>().ReleaseUnused())>> : std::true_type {};
+
+template <class T, class = void>
+struct IsLessComparable : std::false_type {};
+
+template <class T>
+struct IsLessComparable<T, std::void_t<decltype(std::declval<const T &>() < std::declval<const T &>())>>
+    : std::true_type {};
+
+template <class Key, class NodeIterator>
+struct NodeLess {
+  using is_transparent = void;
+
+  struct Probe {
+    size_t hash;
+    const Key *key;
+  };
+
+  static bool Less(size_t lhs_hash, const Key &lhs_key, size_t rhs_hash, const Key &rhs_key) {
+    return lhs_hash != rhs_hash ? lhs_hash < rhs_hash : lhs_key < rhs_key;
+  }
+
+  bool operator()(const NodeIterator &lhs, const NodeIterator &rhs) const {
+    return Less(lhs->hash, lhs->key, rhs->hash, rhs->key);
+  }
+
+  bool operator()(const NodeIterator &lhs, const Probe &rhs) const {
+    return Less(lhs->hash, lhs->key, rhs.hash, *rhs.key);
+  }
+
+  bool operator()(const Probe &lhs, const NodeIterator &rhs) const {
+    return Less(lhs.hash, *lhs.key, rhs->hash, rhs->key);
+  }
+};
+
+template <class Function>
+void RunParallel(size_t n_threads, Function function) {
+  std::vector<std::exception_ptr> errors(n_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  for (size_t i = 0; i < n_threads; ++i) {
+    threads.emplace_back([&, i] {
+      try {
+        function(i);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+}  // namespace unordered_set_detail
 
 template <class Key>
+struct HashNode {
+  Key key;
+  size_t hash;
+
+  template <class... Args>
+  explicit HashNode(size_t hash_value, Args &&...args) : key(std::forward<Args>(args)...), hash(hash_value) {
+  }
+};
+
+template <class Key, class NodeAllocator = std::allocator<HashNode<Key>>>
 class Iterator {
  public:
-  typename std::vector<std::list<Key>>::iterator iterator_vector_;
-  const typename std::vector<std::list<Key>>::iterator iterator_vector_end_;
-  typename std::list<Key>::iterator iterator_list_;
-  typename std::list<Key>::iterator check;
+  using BucketList = std::list<HashNode<Key>, NodeAllocator>;
+
+  typename std::vector<BucketList>::iterator iterator_vector_;
+  const typename std::vector<BucketList>::iterator iterator_vector_end_;
+  typename BucketList::iterator iterator_list_;
 
  public:
-  Iterator(const typename std::vector<std::list<Key>>::iterator &vector,
-           const typename std::vector<std::list<Key>>::iterator &vector_end,
-           const typename std::list<Key>::iterator &list)
+  Iterator(const typename std::vector<BucketList>::iterator &vector,
+           const typename std::vector<BucketList>::iterator &vector_end, const typename BucketList::iterator &list)
       : iterator_vector_(vector), iterator_vector_end_(vector_end), iterator_list_(list){};
 
   Iterator &operator++() {
@@ -45,74 +139,144 @@ class Iterator {
     return copy_iterator;
   }
 
-  typename std::list<Key>::iterator &operator->() {
-    return iterator_list_;
+  Key *operator->() {
+    return &iterator_list_->key;
   }
 
   Key &operator*() {
-    return *iterator_list_;
+    return iterator_list_->key;
   }
 
-  bool operator!=(const Iterator<Key> &other) {
+  bool operator!=(const Iterator &other) {
     return !(*this == other);
   }
 
-  bool operator==(const Iterator<Key> &other) {
+  bool operator==(const Iterator &other) {
     return iterator_list_ == other.iterator_list_;
   }
 };
 
-template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class BucketPolicy = ModuloBucketPolicy, class Allocator = std::allocator<Key>>
 class UnorderedSet {
  private:
-  std::vector<std::list<Key>> set_{};
+  using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<HashNode<Key>>;
+  using BucketList = std::list<HashNode<Key>, NodeAllocator>;
+  using TreeLess = unordered_set_detail::NodeLess<Key, typename BucketList::iterator>;
+  using TreeIndex = std::set<typename BucketList::iterator, TreeLess>;
+
+  std::vector<BucketList> set_{};
   size_t n_bucket_{};
   size_t n_elements_{};
   float load_factor_{};
+  std::vector<BucketList> old_set_{};
+  size_t migrate_pos_{};
+  std::vector<BucketList> next_set_{};
+  std::vector<BucketList> retired_set_{};
+  bool incremental_rehash_{};
+  float min_load_factor_{};
+  Hash hash_{};
+  KeyEqual equal_{};
+  NodeAllocator node_alloc_{};
+  std::map<size_t, TreeIndex> trees_{};
+#ifdef UNORDERED_SET_ENABLE_STATS
+  TableStats stats_;
+#endif
+
+  static constexpr size_t kRehashStep = 2;
+  static constexpr size_t kBucketBuildStep = 8;
+  static constexpr size_t kBatchSize = 16;
+  static constexpr size_t kParallelBuildThreshold = 1 << 16;
+  static constexpr size_t kMinShrinkBucketCount = 8;
+  static constexpr float kMaxMinLoadFactor = 0.5f;
+  static constexpr size_t kTreeifyThreshold = 8;
+  static constexpr size_t kUntreeifyThreshold = 6;
+  static constexpr bool kCanTreeify =
+      unordered_set_detail::IsLessComparable<Key>::value &&
+      (std::is_same_v<KeyEqual, std::equal_to<Key>> || std::is_same_v<KeyEqual, std::equal_to<>>);
+
+  template <class K>
+  static constexpr bool kTreeLookup = kCanTreeify && std::is_same_v<K, Key>;
 
  public:
-  template <class>
+  template <class, class>
   friend class Iterator;
 
  public:
   using ValueType = Key;
   using SizeType = size_t;
   using Hasher = Hash;
+  using KeyEqualType = KeyEqual;
   using Reference = ValueType &;
   using ConstReference = const ValueType &;
-  using IteratorSet = Iterator<Key>;
+  using AllocatorType = Allocator;
+  using IteratorSet = Iterator<Key, NodeAllocator>;
 
  public:
   UnorderedSet() = default;
 
-  explicit UnorderedSet(size_t count) : n_bucket_(count) {
-    set_.resize(count);
+  explicit UnorderedSet(size_t count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+                        const Allocator &alloc = Allocator())
+      : n_bucket_(BucketPolicy::BucketCount(count)), hash_(hash), equal_(equal), node_alloc_(alloc) {
+    set_ = MakeBuckets(n_bucket_);
   }
 
   template <class Iterator, class = std::enable_if_t<std::is_base_of_v<
                                 std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>>>
-  UnorderedSet(Iterator first, Iterator second) : n_bucket_(std::distance(first, second)) {
-    set_.resize(std::distance(first, second));
+  UnorderedSet(Iterator first, Iterator second, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+               const Allocator &alloc = Allocator())
+      : n_bucket_(BucketPolicy::BucketCount(std::distance(first, second)))
+      , hash_(hash)
+      , equal_(equal)
+      , node_alloc_(alloc) {
+    set_ = MakeBuckets(n_bucket_);
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>) {
+      if (static_cast<size_t>(second - first) >= kParallelBuildThreshold) {
+        InsertParallel(first, second);
+        return;
+      }
+    }
     for (auto iter = first; iter != second; ++iter) {
       HashAndPushIfElementIsNotInSet(*iter);
     }
     MakeLoadFactor();
   }
 
-  UnorderedSet(const UnorderedSet &other) = default;
+  UnorderedSet(const UnorderedSet &other)
+      : n_bucket_(other.n_bucket_)
+      , n_elements_(other.n_elements_)
+      , load_factor_(other.load_factor_)
+      , migrate_pos_(other.migrate_pos_)
+      , incremental_rehash_(other.incremental_rehash_)
+      , min_load_factor_(other.min_load_factor_)
+      , hash_(other.hash_)
+      , equal_(other.equal_)
+      , node_alloc_(std::allocator_traits<NodeAllocator>::select_on_container_copy_construction(other.node_alloc_)) {
+    set_ = CopyBuckets(other.set_);
+    old_set_ = CopyBuckets(other.old_set_);
+    RebuildTrees();
+  }
 
   UnorderedSet(UnorderedSet &&other) noexcept
       : set_(std::move(other.set_))
       , n_bucket_(std::exchange(other.n_bucket_, 0))
       , n_elements_(std::exchange(other.n_elements_, 0))
-      , load_factor_(std::exchange(other.load_factor_, 0)){};
+      , load_factor_(std::exchange(other.load_factor_, 0))
+      , old_set_(std::move(other.old_set_))
+      , migrate_pos_(std::exchange(other.migrate_pos_, 0))
+      , next_set_(std::move(other.next_set_))
+      , retired_set_(std::move(other.retired_set_))
+      , incremental_rehash_(other.incremental_rehash_)
+      , min_load_factor_(other.min_load_factor_)
+      , hash_(std::move(other.hash_))
+      , equal_(std::move(other.equal_))
+      , node_alloc_(other.node_alloc_)
+      , trees_(std::move(other.trees_)){};
 
   UnorderedSet &operator=(const UnorderedSet &other) {
     if (this != &other) {
-      set_ = other.set_;
-      n_bucket_ = other.n_bucket_;
-      n_elements_ = other.n_elements_;
-      load_factor_ = other.load_factor_;
+      *this = UnorderedSet(other);
     }
     return *this;
   };
@@ -123,6 +287,16 @@ class UnorderedSet {
       n_bucket_ = std::exchange(other.n_bucket_, 0);
       n_elements_ = std::exchange(other.n_elements_, 0);
       load_factor_ = std::exchange(other.load_factor_, 0);
+      old_set_ = std::move(other.old_set_);
+      migrate_pos_ = std::exchange(other.migrate_pos_, 0);
+      next_set_ = std::move(other.next_set_);
+      retired_set_ = std::move(other.retired_set_);
+      incremental_rehash_ = other.incremental_rehash_;
+      min_load_factor_ = other.min_load_factor_;
+      hash_ = std::move(other.hash_);
+      equal_ = std::move(other.equal_);
+      node_alloc_ = other.node_alloc_;
+      trees_ = std::move(other.trees_);
     }
     return *this;
   };
@@ -130,60 +304,78 @@ class UnorderedSet {
   ~UnorderedSet() noexcept = default;
 
   inline void MakeLoadFactor() {
-    load_factor_ = static_cast<float>(n_elements_) / n_bucket_;
+    load_factor_ = n_bucket_ == 0 ? 0 : static_cast<float>(n_elements_) / n_bucket_;
   }
 
-  SizeType HashValue(const ValueType value) const {
-    return std::hash<Key>{}(value) % n_bucket_;
+  template <class K>
+  size_t HashOf(const K &value) const {
+    return hash_(value);
   }
 
-  std::pair<IteratorSet, bool> CheckIfElementInSetWithIterator(const size_t idx, const ValueType &value) {
-    if (!set_[idx].empty()) {
-      auto iter = set_[idx].begin();
-      for (auto &item : set_[idx]) {
-        if (item == value) {
-          return std::make_pair(IteratorSet(set_.begin() + idx, set_.end(), iter), false);
+  SizeType HashValue(const ValueType &value) const {
+    return BucketPolicy::Index(HashOf(value), n_bucket_);
+  }
+
+  template <class K>
+  std::pair<IteratorSet, bool> CheckIfElementInSetWithIterator(const size_t idx, size_t hash, const K &value) {
+    if constexpr (kTreeLookup<K>) {
+      if (const auto *tree = TreeOf(idx)) {
+        auto node = tree->find(typename TreeLess::Probe{hash, &value});
+        if (node != tree->end()) {
+          return std::make_pair(IteratorSet(set_.begin() + idx, set_.end(), *node), false);
         }
-        iter = std::next(iter);
+        return std::make_pair(IteratorSet(set_.begin() + idx, set_.end(), set_[idx].begin()), true);
+      }
+    }
+    for (auto iter = set_[idx].begin(); iter != set_[idx].end(); ++iter) {
+      if (iter->hash == hash && equal_(iter->key, value)) {
+        return std::make_pair(IteratorSet(set_.begin() + idx, set_.end(), iter), false);
       }
     }
     return std::make_pair(IteratorSet(set_.begin() + idx, set_.end(), set_[idx].begin()), true);
   }
 
-  bool CheckIfElementInSet(const size_t idx, const ValueType &value) const {
+  template <class K>
+  bool CheckIfElementInSet(const size_t idx, size_t hash, const K &value) const {
     if (idx >= n_bucket_) {
       return false;
     }
-    if (!set_[idx].empty()) {
-      for (auto &item : set_[idx]) {
-        if (item == value) {
-          return true;
-        }
+    if constexpr (kTreeLookup<K>) {
+      if (const auto *tree = TreeOf(idx)) {
+        return tree->count(typename TreeLess::Probe{hash, &value}) != 0;
+      }
+    }
+    return CheckIfElementInBucket(set_[idx], hash, value);
+  }
+
+  template <class K>
+  bool CheckIfElementInBucket(const BucketList &bucket, size_t hash, const K &value) const {
+    for (auto &node : bucket) {
+      if (node.hash == hash && equal_(node.key, value)) {
+        return true;
       }
     }
     return false;
   }
 
-  std::pair<IteratorSet, bool> HashAndPushWithIterator(const ValueType &value) {
-    auto idx = HashValue(value);
-    set_[idx].push_front(value);
+  template <class... Args>
+  std::pair<IteratorSet, bool> PushWithIterator(size_t hash, Args &&...args) {
+    auto idx = BucketPolicy::Index(hash, n_bucket_);
+    set_[idx].emplace_front(hash, std::forward<Args>(args)...);
+    IndexNode(idx);
     ++n_elements_;
     MakeLoadFactor();
     return std::make_pair(IteratorSet(set_.begin() + idx, set_.end(), set_[idx].begin()), true);
   }
 
-  void HashAndPush(const ValueType &value) {
-    auto idx = HashValue(value);
-    set_[idx].push_front(value);
-    ++n_elements_;
-  }
-
   bool HashAndPushIfElementIsNotInSet(const ValueType &value) {
-    auto idx = HashValue(value);
-    if (CheckIfElementInSet(idx, value)) {
+    auto hash = HashOf(value);
+    auto idx = BucketPolicy::Index(hash, n_bucket_);
+    if (CheckIfElementInSet(idx, hash, value)) {
       return false;
     }
-    set_[idx].push_front(value);
+    set_[idx].emplace_front(hash, value);
+    IndexNode(idx);
     ++n_elements_;
     return true;
   }
@@ -201,10 +393,17 @@ class UnorderedSet {
   }
 
   IteratorSet end() {  // NOLINT
+    if (set_.empty()) {
+      return IteratorSet(set_.end(), set_.end(), typename BucketList::iterator());
+    }
     return IteratorSet(set_.end(), set_.end(), (--set_.end())->end());
   }
 
   IteratorSet begin() {  // NOLINT
+    FinishMigration();
+    if (n_elements_ == 0) {
+      return end();
+    }
     auto iter = set_.begin();
     while (iter->empty()) {
       ++iter;
@@ -213,70 +412,302 @@ class UnorderedSet {
   }
 
   void Clear() {
+    trees_.clear();
     set_.clear();
+    old_set_.clear();
+    migrate_pos_ = 0;
+    std::vector<BucketList>().swap(next_set_);
+    std::vector<BucketList>().swap(retired_set_);
     n_elements_ = 0;
     n_bucket_ = 0;
     load_factor_ = 0;
+    if constexpr (unordered_set_detail::HasReleaseUnused<NodeAllocator>::value) {
+      node_alloc_.ReleaseUnused();
+    }
   }
 
   void Rehash(size_t new_bucket_count) {
-    if (new_bucket_count < n_elements_ || new_bucket_count == n_bucket_) {
+    FinishMigration();
+    if (new_bucket_count < n_elements_) {
       return;
     }
-    UnorderedSet copy_set = *this;
-    this->Clear();
-    set_.resize(new_bucket_count);
-    n_bucket_ = new_bucket_count;
-    if (copy_set.n_bucket_ == 0) {
+    new_bucket_count = BucketPolicy::BucketCount(new_bucket_count);
+    if (new_bucket_count == n_bucket_) {
       return;
     }
-    for (auto &item : copy_set) {
-      HashAndPush(item);
+#ifdef UNORDERED_SET_ENABLE_STATS
+    TableStats::RehashTimer timer(stats_);
+#endif
+    std::vector<BucketList> old_set = MakeBuckets(new_bucket_count);
+    old_set.swap(set_);
+    trees_.clear();
+    n_bucket_ = new_bucket_count;
+    for (auto &bucket : old_set) {
+      RelinkBucket(bucket);
     }
     MakeLoadFactor();
   }
 
   [[nodiscard]] bool Find(const ValueType &value) const {
+    return FindImpl(value);
+  }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = std::enable_if_t<unordered_set_detail::IsTransparent<H>::value &&
+                                     unordered_set_detail::IsTransparent<E>::value>>
+  [[nodiscard]] bool Find(const K &value) const {
+    return FindImpl(value);
+  }
+
+  void FindBatch(const ValueType *values, size_t count, bool *found) const {
+    size_t hashes[kBatchSize];
+    const ValueType *pointers[kBatchSize];
+    for (size_t first = 0; first < count; first += kBatchSize) {
+      size_t batch = std::min(kBatchSize, count - first);
+      for (size_t i = 0; i < batch; ++i) {
+        hashes[i] = HashOf(values[first + i]);
+        pointers[i] = &values[first + i];
+      }
+      FindBatchWithHash(hashes, pointers, batch, found + first);
+    }
+  }
+
+  void FindBatchWithHash(const size_t *hashes, const ValueType *const *values, size_t count, bool *found) const {
+    if (n_bucket_ == 0) {
+      std::fill(found, found + count, false);
+      return;
+    }
+    for (size_t first = 0; first < count; first += kBatchSize) {
+      size_t batch = std::min(kBatchSize, count - first);
+      for (size_t i = first; i < first + batch; ++i) {
+        __builtin_prefetch(&set_[BucketPolicy::Index(hashes[i], n_bucket_)]);
+      }
+      for (size_t i = first; i < first + batch; ++i) {
+        const auto &bucket = set_[BucketPolicy::Index(hashes[i], n_bucket_)];
+        if (!bucket.empty()) {
+          __builtin_prefetch(&bucket.front());
+        }
+      }
+      for (size_t i = first; i < first + batch; ++i) {
+        found[i] = FindWithHash(hashes[i], *values[i]);
+      }
+    }
+  }
+
+  size_t InsertBatch(const ValueType *values, size_t count) {
+    size_t hashes[kBatchSize];
+    size_t inserted = 0;
+    for (size_t first = 0; first < count; first += kBatchSize) {
+      size_t batch = std::min(kBatchSize, count - first);
+      for (size_t i = 0; i < batch; ++i) {
+        hashes[i] = HashOf(values[first + i]);
+        if (n_bucket_ != 0) {
+          __builtin_prefetch(&set_[BucketPolicy::Index(hashes[i], n_bucket_)]);
+        }
+      }
+      for (size_t i = 0; i < batch; ++i) {
+        inserted += InsertWithHash(hashes[i], values[first + i]).second ? 1 : 0;
+      }
+    }
+    return inserted;
+  }
+
+  template <class Iterator,
+            class = std::enable_if_t<std::is_base_of_v<std::random_access_iterator_tag,
+                                                       typename std::iterator_traits<Iterator>::iterator_category>>>
+  size_t InsertParallel(Iterator first, Iterator second,
+                        size_t n_threads = std::max(1u, std::thread::hardware_concurrency())) {
+    size_t count = second - first;
+    FinishMigration();
+    if (BucketPolicy::BucketCount(n_elements_ + count) > n_bucket_) {
+      Rehash(n_elements_ + count);
+    }
+    if (!std::allocator_traits<NodeAllocator>::is_always_equal::value) {
+      n_threads = 1;
+    }
+    n_threads = std::max<size_t>(1, std::min(n_threads, count / kBatchSize));
+    if (n_threads == 1) {
+      size_t inserted = 0;
+      for (auto iter = first; iter != second; ++iter) {
+        inserted += HashAndPushIfElementIsNotInSet(*iter) ? 1 : 0;
+      }
+      MakeLoadFactor();
+      return inserted;
+    }
+    size_t chunk = (count + n_threads - 1) / n_threads;
+    size_t part_width = (n_bucket_ + n_threads - 1) / n_threads;
+    std::vector<size_t> hashes(count);
+    std::vector<size_t> offsets(n_threads * n_threads);
+    unordered_set_detail::RunParallel(n_threads, [&](size_t thread) {
+      size_t *thread_offsets = &offsets[thread * n_threads];
+      for (size_t i = thread * chunk; i < std::min(count, (thread + 1) * chunk); ++i) {
+        hashes[i] = HashOf(first[i]);
+        ++thread_offsets[BucketPolicy::Index(hashes[i], n_bucket_) / part_width];
+      }
+    });
+    std::vector<size_t> part_begin(n_threads + 1);
+    for (size_t part = 0, sum = 0; part < n_threads; ++part) {
+      part_begin[part] = sum;
+      for (size_t thread = 0; thread < n_threads; ++thread) {
+        sum += std::exchange(offsets[thread * n_threads + part], sum);
+      }
+      part_begin[part + 1] = sum;
+    }
+    std::vector<size_t> order(count);
+    unordered_set_detail::RunParallel(n_threads, [&](size_t thread) {
+      size_t *thread_offsets = &offsets[thread * n_threads];
+      for (size_t i = thread * chunk; i < std::min(count, (thread + 1) * chunk); ++i) {
+        order[thread_offsets[BucketPolicy::Index(hashes[i], n_bucket_) / part_width]++] = i;
+      }
+    });
+    std::vector<size_t> inserted(n_threads);
+    std::exception_ptr error;
+    try {
+      unordered_set_detail::RunParallel(n_threads, [&](size_t part) {
+        size_t part_inserted = 0;
+        try {
+          for (size_t pos = part_begin[part]; pos < part_begin[part + 1]; ++pos) {
+            size_t i = order[pos];
+            auto &bucket = set_[BucketPolicy::Index(hashes[i], n_bucket_)];
+            if (!CheckIfElementInBucket(bucket, hashes[i], first[i])) {
+              bucket.emplace_front(hashes[i], first[i]);
+              ++part_inserted;
+            }
+          }
+        } catch (...) {
+          inserted[part] = part_inserted;
+          throw;
+        }
+        inserted[part] = part_inserted;
+      });
+    } catch (...) {
+      error = std::current_exception();
+    }
+    size_t total = 0;
+    for (auto part_inserted : inserted) {
+      total += part_inserted;
+    }
+    n_elements_ += total;
+    MakeLoadFactor();
+    RebuildTrees();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return total;
+  }
+
+  template <class K>
+  bool FindWithHash(size_t hash, const K &value) const {
     if (n_bucket_ == 0) {
       return false;
     }
-    auto idx = HashValue(value);
-    return CheckIfElementInSet(idx, value);
+    size_t probes = 0;
+    bool found = ProbeBucket(BucketPolicy::Index(hash, n_bucket_), hash, value, probes);
+    if (!found && !old_set_.empty()) {
+      found = ProbeBucket(old_set_[BucketPolicy::Index(hash, old_set_.size())], hash, value, probes);
+    }
+#ifdef UNORDERED_SET_ENABLE_STATS
+    stats_.RecordFind(found, probes);
+#endif
+    return found;
   }
 
-  std::pair<IteratorSet, bool> Insert(const ValueType &insert_value) {
+  std::pair<IteratorSet, bool> InsertWithHash(size_t hash, const ValueType &insert_value) {
+    return EmplaceWithHash(hash, insert_value, insert_value);
+  }
+
+  std::pair<IteratorSet, bool> InsertWithHash(size_t hash, ValueType &&insert_value) {
+    return EmplaceWithHash(hash, insert_value, std::move(insert_value));
+  }
+
+  template <class K>
+  std::pair<IteratorSet, bool> LocateWithHash(size_t hash, const K &key) {
     if (n_bucket_ == 0) {
-      ++n_bucket_;
-      set_.resize(1);
-      return HashAndPushWithIterator(insert_value);
+      return std::make_pair(end(), false);
     }
-    std::pair<IteratorSet, bool> pair = CheckIfElementInSetWithIterator(HashValue(insert_value), insert_value);
+    MigrateStep(hash);
+    auto idx = BucketPolicy::Index(hash, n_bucket_);
+    std::pair<IteratorSet, bool> pair = CheckIfElementInSetWithIterator(idx, hash, key);
+    return std::make_pair(pair.first, !pair.second);
+  }
+
+  template <class K, class... Args>
+  std::pair<IteratorSet, bool> EmplaceWithHash(size_t hash, const K &key, Args &&...args) {
+    if (n_bucket_ == 0) {
+      n_bucket_ = BucketPolicy::BucketCount(1);
+      set_ = MakeBuckets(n_bucket_);
+      return PushWithIterator(hash, std::forward<Args>(args)...);
+    }
+    MigrateStep(hash);
+    auto idx = BucketPolicy::Index(hash, n_bucket_);
+    std::pair<IteratorSet, bool> pair = CheckIfElementInSetWithIterator(idx, hash, key);
     if (!pair.second) {
       return pair;
     }
+    BuildNextBucketsStep();
     if (CheckLoadFactor()) {
-      return HashAndPushWithIterator(insert_value);
+      return PushWithIterator(hash, std::forward<Args>(args)...);
+    }
+    if (incremental_rehash_) {
+      StartIncrementalRehash(BucketPolicy::BucketCount(2 * n_bucket_));
+    } else {
+      Rehash(BucketPolicy::BucketCount(2 * n_bucket_));
     }
-    Rehash(2 * n_bucket_);
-    return HashAndPushWithIterator(insert_value);
+    return PushWithIterator(hash, std::forward<Args>(args)...);
+  }
+
+  std::pair<IteratorSet, bool> Insert(const ValueType &insert_value) {
+    return InsertWithHash(HashOf(insert_value), insert_value);
   }
 
   std::pair<IteratorSet, bool> Insert(ValueType &&insert_value) {
-    ValueType copy_insert_value = std::move(insert_value);
-    return Insert(copy_insert_value);
+    auto hash = HashOf(insert_value);
+    return InsertWithHash(hash, std::move(insert_value));
   }
 
   size_t Erase(const ValueType &erase_value) {
-    std::pair<IteratorSet, bool> pair = CheckIfElementInSetWithIterator(HashValue(erase_value), erase_value);
+    if (n_bucket_ == 0) {
+      return 0;
+    }
+    return EraseWithHash(HashOf(erase_value), erase_value);
+  }
+
+  template <class K>
+  size_t EraseWithHash(size_t hash, const K &erase_value) {
+    if (n_bucket_ == 0) {
+      return 0;
+    }
+    MigrateStep(hash);
+    auto idx = BucketPolicy::Index(hash, n_bucket_);
+    std::pair<IteratorSet, bool> pair = CheckIfElementInSetWithIterator(idx, hash, erase_value);
     if (pair.second) {
       return 0;
     }
+    UnindexNode(idx, pair.first.iterator_list_);
     pair.first.iterator_vector_->erase(pair.first.iterator_list_);
     --n_elements_;
     MakeLoadFactor();
+    ShrinkIfSparse();
     return 1;
   }
 
+  template <class Function>
+  void ForEachWithHash(Function function) const {
+    ForEachWithHash(0, 1, function);
+  }
+
+  template <class Function>
+  void ForEachWithHash(size_t part, size_t n_parts, Function function) const {
+    for (const auto *buckets : {&set_, &old_set_}) {
+      size_t last = buckets->size() * (part + 1) / n_parts;
+      for (size_t i = buckets->size() * part / n_parts; i < last; ++i) {
+        for (const auto &node : (*buckets)[i]) {
+          function(node.key, node.hash);
+        }
+      }
+    }
+  }
+
   void Reserve(size_t new_bucket_count) {
     if (new_bucket_count > n_bucket_) {
       Rehash(new_bucket_count);
@@ -294,13 +725,305 @@ class UnorderedSet {
     return set_[id].size();
   }
 
-  [[nodiscard]] size_t Bucket(ValueType value) const {
+  [[nodiscard]] size_t Bucket(const ValueType &value) const {
     return HashValue(value);
   }
 
   [[nodiscard]] float LoadFactor() const {
     return load_factor_;
   }
+
+  [[nodiscard]] Hasher HashFunction() const {
+    return hash_;
+  }
+
+  [[nodiscard]] KeyEqualType KeyEq() const {
+    return equal_;
+  }
+
+  [[nodiscard]] AllocatorType GetAllocator() const {
+    return AllocatorType(node_alloc_);
+  }
+
+  void SetIncrementalRehash(bool enabled) {
+    if (!enabled) {
+      FinishMigration();
+    }
+    incremental_rehash_ = enabled;
+  }
+
+  [[nodiscard]] bool IsRehashing() const {
+    return !old_set_.empty();
+  }
+
+  void SetMinLoadFactor(float min_load_factor) {
+    if (!(min_load_factor >= 0 && min_load_factor <= kMaxMinLoadFactor)) {
+      throw std::invalid_argument("UnorderedSet: min load factor must be in [0, 0.5]");
+    }
+    min_load_factor_ = min_load_factor;
+    ShrinkIfSparse();
+  }
+
+  [[nodiscard]] float MinLoadFactor() const {
+    return min_load_factor_;
+  }
+
+  void ShrinkToFit() {
+    FinishMigration();
+    if (n_elements_ == 0) {
+      Clear();
+      std::vector<BucketList>().swap(set_);
+      return;
+    }
+    UnorderedSet compact(n_elements_, hash_, equal_,
+                         std::allocator_traits<NodeAllocator>::select_on_container_copy_construction(node_alloc_));
+    for (auto &bucket : set_) {
+      for (auto &node : bucket) {
+        compact.PushWithIterator(node.hash, std::move_if_noexcept(node.key));
+      }
+    }
+    compact.incremental_rehash_ = incremental_rehash_;
+    compact.min_load_factor_ = min_load_factor_;
+    *this = std::move(compact);
+  }
+
+  [[nodiscard]] size_t TreeifiedBucketCount() const {
+    return trees_.size();
+  }
+
+#ifdef UNORDERED_SET_ENABLE_STATS
+  [[nodiscard]] StatsSnapshot Stats() const {
+    StatsSnapshot snapshot;
+    stats_.Fill(snapshot);
+    for (const auto *buckets : {&set_, &old_set_}) {
+      for (const auto &bucket : *buckets) {
+        if (bucket.size() >= snapshot.chain_histogram.size()) {
+          snapshot.chain_histogram.resize(bucket.size() + 1);
+        }
+        ++snapshot.chain_histogram[bucket.size()];
+      }
+    }
+    size_t bucket_capacity = set_.capacity() + old_set_.capacity() + next_set_.capacity() + retired_set_.capacity();
+    snapshot.bytes = bucket_capacity * sizeof(BucketList) +
+                     n_elements_ * (sizeof(HashNode<Key>) + 2 * sizeof(void *));
+    return snapshot;
+  }
+
+  void ResetStats() {
+    stats_.Reset();
+  }
+
+  void DumpStats(std::ostream &os, const std::string &prefix = "unordered_set") const {
+    Stats().Dump(os, prefix);
+  }
+#endif
+
+ private:
+  std::vector<BucketList> MakeBuckets(size_t count) const {
+    std::vector<BucketList> buckets;
+    buckets.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      buckets.emplace_back(node_alloc_);
+    }
+    return buckets;
+  }
+
+  template <class K>
+  bool ProbeBucket(size_t idx, size_t hash, const K &value, size_t &probes) const {
+    if constexpr (kTreeLookup<K>) {
+      if (const auto *tree = TreeOf(idx)) {
+        ++probes;
+        return tree->count(typename TreeLess::Probe{hash, &value}) != 0;
+      }
+    }
+    return ProbeBucket(set_[idx], hash, value, probes);
+  }
+
+  template <class K>
+  bool ProbeBucket(const BucketList &bucket, size_t hash, const K &value, size_t &probes) const {
+    for (auto &node : bucket) {
+      ++probes;
+      if (node.hash == hash && equal_(node.key, value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<BucketList> CopyBuckets(const std::vector<BucketList> &other) const {
+    std::vector<BucketList> buckets = MakeBuckets(other.size());
+    for (size_t i = 0; i < other.size(); ++i) {
+      buckets[i].insert(buckets[i].end(), other[i].begin(), other[i].end());
+    }
+    return buckets;
+  }
+
+  template <class K>
+  bool FindImpl(const K &value) const {
+    if (n_bucket_ == 0) {
+      return false;
+    }
+    return FindWithHash(HashOf(value), value);
+  }
+
+  void StartIncrementalRehash(size_t new_bucket_count) {
+    FinishMigration();
+#ifdef UNORDERED_SET_ENABLE_STATS
+    TableStats::RehashTimer timer(stats_);
+#endif
+    trees_.clear();
+    old_set_ = std::move(set_);
+    set_ = TakeNextBuckets(new_bucket_count);
+    n_bucket_ = new_bucket_count;
+    migrate_pos_ = 0;
+    MakeLoadFactor();
+  }
+
+  void ShrinkIfSparse() {
+    if (min_load_factor_ == 0 || load_factor_ >= min_load_factor_ || n_bucket_ <= kMinShrinkBucketCount) {
+      return;
+    }
+    float target_load_factor = (min_load_factor_ + 1) / 2;
+    auto new_bucket_count = BucketPolicy::BucketCount(static_cast<size_t>(n_elements_ / target_load_factor) + 1);
+    if (new_bucket_count < n_bucket_) {
+      Rehash(new_bucket_count);
+    }
+  }
+
+  const TreeIndex *TreeOf(size_t idx) const {
+    if (trees_.empty()) {
+      return nullptr;
+    }
+    auto tree = trees_.find(idx);
+    return tree == trees_.end() ? nullptr : &tree->second;
+  }
+
+  void IndexNode(size_t idx) {
+    if constexpr (kCanTreeify) {
+      if (trees_.empty() && set_[idx].size() <= kTreeifyThreshold) {
+        return;
+      }
+      auto tree = trees_.find(idx);
+      if (tree != trees_.end()) {
+        tree->second.insert(set_[idx].begin());
+      } else if (set_[idx].size() > kTreeifyThreshold) {
+        Treeify(idx);
+      }
+    }
+  }
+
+  void UnindexNode(size_t idx, typename BucketList::iterator node) {
+    if (trees_.empty()) {
+      return;
+    }
+    auto tree = trees_.find(idx);
+    if (tree == trees_.end()) {
+      return;
+    }
+    if (set_[idx].size() - 1 <= kUntreeifyThreshold) {
+      trees_.erase(tree);
+    } else {
+      tree->second.erase(node);
+    }
+  }
+
+  void Treeify(size_t idx) {
+    TreeIndex tree;
+    for (auto node = set_[idx].begin(); node != set_[idx].end(); ++node) {
+      tree.insert(node);
+    }
+    trees_.emplace(idx, std::move(tree));
+  }
+
+  void RebuildTrees() {
+    trees_.clear();
+    if constexpr (kCanTreeify) {
+      for (size_t idx = 0; idx < set_.size(); ++idx) {
+        if (set_[idx].size() > kTreeifyThreshold) {
+          Treeify(idx);
+        }
+      }
+    }
+  }
+
+  void RelinkBucket(BucketList &bucket) {
+    while (!bucket.empty()) {
+      auto idx = BucketPolicy::Index(bucket.front().hash, n_bucket_);
+      set_[idx].splice(set_[idx].begin(), bucket, bucket.begin());
+      IndexNode(idx);
+    }
+  }
+
+  // Between rehashes the next bucket array is built and the previous one destroyed a few buckets per
+  // insert, so the insert that crosses the load factor neither constructs nor frees O(n) buckets.
+  void BuildNextBucketsStep() {
+    if (!incremental_rehash_ || !old_set_.empty() || load_factor_ < 0.5f) {
+      return;
+    }
+    size_t count = BucketPolicy::BucketCount(2 * n_bucket_);
+    if (next_set_.capacity() != count) {
+      std::vector<BucketList>().swap(next_set_);
+      next_set_.reserve(count);
+    }
+    for (size_t step = 0; step < kBucketBuildStep && next_set_.size() < count; ++step) {
+      next_set_.emplace_back(node_alloc_);
+    }
+  }
+
+  std::vector<BucketList> TakeNextBuckets(size_t count) {
+    if (next_set_.capacity() != count) {
+      std::vector<BucketList>().swap(next_set_);
+      return MakeBuckets(count);
+    }
+    while (next_set_.size() < count) {
+      next_set_.emplace_back(node_alloc_);
+    }
+    return std::move(next_set_);
+  }
+
+  void DestroyRetiredStep() {
+    for (size_t step = 0; step < kBucketBuildStep && !retired_set_.empty(); ++step) {
+      retired_set_.pop_back();
+    }
+    if (retired_set_.empty()) {
+      std::vector<BucketList>().swap(retired_set_);
+    }
+  }
+
+  void MigrateStep(size_t hash) {
+    if (!retired_set_.empty()) {
+      DestroyRetiredStep();
+    }
+    if (old_set_.empty()) {
+      return;
+    }
+#ifdef UNORDERED_SET_ENABLE_STATS
+    TableStats::RehashTimer timer(stats_, 0);
+#endif
+    RelinkBucket(old_set_[BucketPolicy::Index(hash, old_set_.size())]);
+    for (size_t step = 0; step < kRehashStep && migrate_pos_ < old_set_.size(); ++step) {
+      RelinkBucket(old_set_[migrate_pos_++]);
+    }
+    if (migrate_pos_ == old_set_.size()) {
+      retired_set_ = std::move(old_set_);
+      old_set_.clear();
+      migrate_pos_ = 0;
+    }
+  }
+
+  void FinishMigration() {
+    if (old_set_.empty()) {
+      return;
+    }
+#ifdef UNORDERED_SET_ENABLE_STATS
+    TableStats::RehashTimer timer(stats_, 0);
+#endif
+    while (migrate_pos_ < old_set_.size()) {
+      RelinkBucket(old_set_[migrate_pos_++]);
+    }
+    std::vector<BucketList>().swap(old_set_);
+    migrate_pos_ = 0;
+  }
 };
 
 #endif  // UNORDERED_SET_UNORDERED_SET_H
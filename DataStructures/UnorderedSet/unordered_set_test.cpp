@@ -0,0 +1,125 @@
+// Checks that UnorderedSet growth relinks nodes instead of copying keys.
+//   g++ -std=c++17 -g -fsanitize=address,undefined unordered_set_test.cpp -o unordered_set_test && ./unordered_set_test
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "unordered_set.h"
+
+namespace {
+
+struct CountingKey {
+  static inline size_t copies = 0;
+  static inline size_t moves = 0;
+
+  int value;
+
+  explicit CountingKey(int key_value) : value(key_value) {
+  }
+
+  CountingKey(const CountingKey &other) : value(other.value) {
+    ++copies;
+  }
+
+  CountingKey(CountingKey &&other) noexcept : value(other.value) {
+    ++moves;
+  }
+
+  CountingKey &operator=(const CountingKey &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+
+  CountingKey &operator=(CountingKey &&other) noexcept {
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+
+  bool operator==(const CountingKey &other) const {
+    return value == other.value;
+  }
+};
+
+struct CountingKeyHash {
+  size_t operator()(const CountingKey &key) const {
+    return std::hash<int>()(key.value);
+  }
+};
+
+struct MoveOnlyKey {
+  std::unique_ptr<int> value;
+
+  explicit MoveOnlyKey(int key_value) : value(std::make_unique<int>(key_value)) {
+  }
+
+  bool operator==(const MoveOnlyKey &other) const {
+    return *value == *other.value;
+  }
+};
+
+struct MoveOnlyKeyHash {
+  size_t operator()(const MoveOnlyKey &key) const {
+    return std::hash<int>()(*key.value);
+  }
+};
+
+constexpr int kKeys = 10000;
+
+void InsertGrowthDoesNotCopy(bool incremental) {
+  UnorderedSet<CountingKey, CountingKeyHash> set;
+  set.SetIncrementalRehash(incremental);
+  CountingKey::copies = 0;
+  CountingKey::moves = 0;
+  for (int i = 0; i < kKeys; ++i) {
+    set.Insert(CountingKey(i));
+  }
+  assert(set.Size() == kKeys);
+  assert(set.BucketCount() >= kKeys);
+  assert(CountingKey::copies == 0);
+  assert(CountingKey::moves == kKeys);
+  for (int i = 0; i < kKeys; ++i) {
+    assert(set.Find(CountingKey(i)));
+  }
+}
+
+void ReserveDoesNotCopy() {
+  UnorderedSet<CountingKey, CountingKeyHash> set;
+  for (int i = 0; i < kKeys; ++i) {
+    set.Insert(CountingKey(i));
+  }
+  CountingKey::copies = 0;
+  CountingKey::moves = 0;
+  set.Reserve(set.BucketCount() * 8);
+  set.Rehash(set.BucketCount() * 2);
+  assert(CountingKey::copies == 0);
+  assert(CountingKey::moves == 0);
+  for (int i = 0; i < kKeys; ++i) {
+    assert(set.Find(CountingKey(i)));
+  }
+}
+
+void MoveOnlyKeysGrow() {
+  UnorderedSet<MoveOnlyKey, MoveOnlyKeyHash> set;
+  for (int i = 0; i < kKeys; ++i) {
+    set.Insert(MoveOnlyKey(i));
+  }
+  set.Reserve(set.BucketCount() * 4);
+  assert(set.Size() == kKeys);
+  for (int i = 0; i < kKeys; ++i) {
+    assert(set.Find(MoveOnlyKey(i)));
+  }
+  assert(!set.Find(MoveOnlyKey(kKeys)));
+}
+
+}  // namespace
+
+int main() {
+  InsertGrowthDoesNotCopy(false);
+  InsertGrowthDoesNotCopy(true);
+  ReserveDoesNotCopy();
+  MoveOnlyKeysGrow();
+}
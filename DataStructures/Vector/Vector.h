@@ -6,33 +6,96 @@
 #include <type_traits>
 #include <memory>
 #include <algorithm>
+#include <iterator>
 #pragma once
 
-template <typename T>
+template <typename T, class Allocator = std::allocator<T>>
 class Vector {
  private:
   void* buffer_;
   size_t size_;
   size_t capacity_;
+  Allocator allocator_;
 
-  template <typename U>
-  friend bool operator<(const Vector<U>& first, const Vector<U>& second);
-  template <typename U>
-  friend bool operator<=(const Vector<U>& first, const Vector<U>& second);
-  template <typename U>
-  friend bool operator>(const Vector<U>& first, const Vector<U>& second);
-  template <typename U>
-  friend bool operator>=(const Vector<U>& first, const Vector<U>& second);
-  template <typename U>
-  friend bool operator==(const Vector<U>& first, const Vector<U>& second);
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
+  static constexpr bool kPropagateOnCopy = AllocatorTraits::propagate_on_container_copy_assignment::value;
+  static constexpr bool kPropagateOnMove = AllocatorTraits::propagate_on_container_move_assignment::value;
+  static constexpr bool kPropagateOnSwap = AllocatorTraits::propagate_on_container_swap::value;
+  static constexpr bool kAlwaysEqual = AllocatorTraits::is_always_equal::value;
+
+  template <typename U, class A>
+  friend bool operator<(const Vector<U, A>& first, const Vector<U, A>& second);
+  template <typename U, class A>
+  friend bool operator<=(const Vector<U, A>& first, const Vector<U, A>& second);
+  template <typename U, class A>
+  friend bool operator>(const Vector<U, A>& first, const Vector<U, A>& second);
+  template <typename U, class A>
+  friend bool operator>=(const Vector<U, A>& first, const Vector<U, A>& second);
+  template <typename U, class A>
+  friend bool operator==(const Vector<U, A>& first, const Vector<U, A>& second);
+
+  void* Allocate(size_t count) {
+    return AllocatorTraits::allocate(allocator_, count);
+  }
+
+  void Deallocate(void* buffer, size_t count) noexcept {
+    if (buffer != nullptr) {
+      AllocatorTraits::deallocate(allocator_, static_cast<T*>(buffer), count);
+    }
+  }
+
+  void ReleaseStorage() noexcept {
+    std::destroy(begin(), end());
+    Deallocate(buffer_, capacity_);
+    buffer_ = nullptr;
+    size_ = capacity_ = 0;
+  }
+
+  void StealStorage(Vector& other) noexcept {
+    buffer_ = other.buffer_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.buffer_ = nullptr;
+    other.size_ = other.capacity_ = 0;
+  }
+
+  // Replaces the elements with count elements read from source, reusing the current buffer when it is large enough.
+  // A std::move_iterator source moves the elements instead of copying them.
+  template <class Source>
+  void AssignElements(Source source, size_t count) {
+    if (capacity_ < count) {
+      auto new_buffer = Allocate(count);
+      try {
+        std::uninitialized_copy_n(source, count, static_cast<Pointer>(new_buffer));
+      } catch (...) {
+        Deallocate(new_buffer, count);
+        throw;
+      }
+      std::destroy(begin(), end());
+      Deallocate(buffer_, capacity_);
+      buffer_ = new_buffer;
+      size_ = capacity_ = count;
+    } else if (size_ > count) {
+      std::copy_n(source, count, static_cast<Pointer>(buffer_));
+      std::destroy(begin() + count, begin() + size_);
+      size_ = count;
+    } else {
+      std::copy_n(source, size_, static_cast<Pointer>(buffer_));
+      std::uninitialized_copy_n(source + size_, count - size_, static_cast<Pointer>(buffer_) + size_);
+      size_ = count;
+    }
+  }
+
+  size_t NextCapacity() const noexcept {
+    return capacity_ == 0 ? 1 : capacity_ * 2;
+  }
 
   void* Extend() {
-    if (capacity_ == 0) {
-      auto new_buffer = operator new(sizeof(ValueType));
-      return new_buffer;
+    auto new_buffer = Allocate(NextCapacity());
+    if (capacity_ != 0) {
+      std::uninitialized_move_n(static_cast<T*>(buffer_), size_, static_cast<T*>(new_buffer));
     }
-    auto new_buffer = operator new(capacity_ * 2 * sizeof(ValueType));
-    std::uninitialized_move_n(static_cast<Pointer>(buffer_), size_, static_cast<Pointer>(new_buffer));
     return new_buffer;
   }
 
@@ -47,19 +110,23 @@ class Vector {
   using ConstIterator = const T*;
   using ReverseIterator = std::reverse_iterator<Iterator>;
   using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+  using AllocatorType = Allocator;
+
+  Vector() : Vector(Allocator()) {
+  }
 
-  Vector() : buffer_(nullptr), size_(0), capacity_(0) {
+  explicit Vector(const Allocator& alloc) : buffer_(nullptr), size_(0), capacity_(0), allocator_(alloc) {
   }
 
-  explicit Vector(size_t size) : Vector() {
+  explicit Vector(size_t size, const Allocator& alloc = Allocator()) : Vector(alloc) {
     if (size == 0) {
       return;
     }
-    auto new_buffer = operator new(sizeof(ValueType) * size);
+    auto new_buffer = Allocate(size);
     try {
       std::uninitialized_default_construct_n(static_cast<Pointer>(new_buffer), size);
     } catch (...) {
-      operator delete(new_buffer);
+      Deallocate(new_buffer, size);
       throw;
     }
     buffer_ = new_buffer;
@@ -67,15 +134,15 @@ class Vector {
     capacity_ = size;
   }
 
-  Vector(size_t size, ConstReference value) : Vector() {
+  Vector(size_t size, ConstReference value, const Allocator& alloc = Allocator()) : Vector(alloc) {
     if (size == 0) {
       return;
     }
-    auto new_buffer = operator new(sizeof(ValueType) * size);
+    auto new_buffer = Allocate(size);
     try {
       std::uninitialized_fill_n(static_cast<Pointer>(new_buffer), size, value);
     } catch (...) {
-      operator delete(new_buffer);
+      Deallocate(new_buffer, size);
       throw;
     }
     capacity_ = size_ = size;
@@ -84,126 +151,113 @@ class Vector {
 
   template <class Iterator, class = std::enable_if_t<std::is_base_of_v<
                                 std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>>>
-  Vector(Iterator first, Iterator second) : Vector() {
+  Vector(Iterator first, Iterator second, const Allocator& alloc = Allocator()) : Vector(alloc) {
     if (first == second) {
       return;
     }
     size_t size = second - first;
-    auto new_buffer = operator new(size * sizeof(T));
+    auto new_buffer = Allocate(size);
     try {
       std::uninitialized_copy(first, second, static_cast<Pointer>(new_buffer));
     } catch (...) {
-      operator delete(new_buffer);
+      Deallocate(new_buffer, size);
       throw;
     }
     size_ = capacity_ = size;
     buffer_ = new_buffer;
   }
 
-  Vector(const std::initializer_list<T>& list) : Vector() {
+  Vector(const std::initializer_list<T>& list, const Allocator& alloc = Allocator()) : Vector(alloc) {
     if (list.size() == 0) {
       return;
     }
     size_t size = list.size();
-    auto new_buffer = operator new(size * sizeof(ValueType));
+    auto new_buffer = Allocate(size);
     try {
       std::uninitialized_copy(list.begin(), list.end(), static_cast<Pointer>(new_buffer));
     } catch (...) {
-      operator delete(new_buffer);
+      Deallocate(new_buffer, size);
       throw;
     }
     size_ = capacity_ = size;
     buffer_ = new_buffer;
   }
 
-  Vector(const Vector<T>& other) : Vector() {
-    if (other.size_ == 0) {
-      return;
-    }
-    auto new_buffer = operator new(other.size_ * sizeof(ValueType));
-    try {
-      std::uninitialized_copy(other.begin(), other.end(), static_cast<Pointer>(new_buffer));
-    } catch (...) {
-      operator delete(new_buffer);
-      throw;
-    }
-    buffer_ = new_buffer;
-    size_ = capacity_ = other.size_;
+  Vector(const Vector& other)
+      : Vector(other, AllocatorTraits::select_on_container_copy_construction(other.allocator_)) {
+  }
+
+  Vector(const Vector& other, const Allocator& alloc) : Vector(alloc) {
+    AssignElements(other.begin(), other.size_);
   }
 
-  Vector(Vector<T>&& other) : buffer_(other.buffer_), size_(other.size_), capacity_(other.size_) {
+  Vector(Vector&& other) noexcept
+      : buffer_(other.buffer_), size_(other.size_), capacity_(other.capacity_), allocator_(other.allocator_) {
     other.size_ = other.capacity_ = 0;
     other.buffer_ = nullptr;
   }
 
-  Vector& operator=(const Vector<T>& other) {
+  Vector(Vector&& other, const Allocator& alloc) : Vector(alloc) {
+    if (allocator_ == other.allocator_) {
+      StealStorage(other);
+      return;
+    }
+    AssignElements(std::make_move_iterator(other.begin()), other.size_);
+    other.Clear();
+  }
+
+  Vector& operator=(const Vector& other) {
     if (this == &other) {
       return *this;
     }
-    if (capacity_ < other.size_) {
-      auto new_buffer = operator new(other.size_ * sizeof(ValueType));
-      try {
-        std::uninitialized_copy(other.begin(), other.end(), static_cast<Pointer>(new_buffer));
-      } catch (...) {
-        operator delete(new_buffer);
-        throw;
+    if constexpr (kPropagateOnCopy) {
+      if (allocator_ != other.allocator_) {
+        ReleaseStorage();
       }
-      std::destroy(begin(), end());
-      operator delete(buffer_);
-      buffer_ = new_buffer;
-      size_ = capacity_ = other.size_;
-    } else if (size_ > other.size_) {
-      std::copy(other.begin(), other.end(), static_cast<Pointer>(buffer_));
-      std::destroy(begin() + other.size_, begin() + size_);
-      size_ = other.size_;
-    } else {
-      std::copy(other.begin(), other.begin() + size_, static_cast<Pointer>(buffer_));
-      std::uninitialized_copy(other.begin() + size_, other.end(), static_cast<Pointer>(buffer_) + size_);
-      size_ = other.size_;
+      allocator_ = other.allocator_;
     }
+    AssignElements(other.begin(), other.size_);
     return *this;
   }
 
-  Vector& operator=(Vector<T>&& other) noexcept {
-    std::destroy(begin(), end());
-    operator delete(buffer_);
-    buffer_ = other.buffer_;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    other.buffer_ = nullptr;
-    other.size_ = other.capacity_ = 0;
+  // With an allocator that neither propagates on move assignment nor is always equal, the buffer of other can only
+  // be taken when both allocators are equal; otherwise the elements are moved one by one into this vector's storage.
+  Vector& operator=(Vector&& other) noexcept(kPropagateOnMove || kAlwaysEqual) {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (!kPropagateOnMove && !kAlwaysEqual) {
+      if (allocator_ != other.allocator_) {
+        AssignElements(std::make_move_iterator(other.begin()), other.size_);
+        other.Clear();
+        return *this;
+      }
+    }
+    ReleaseStorage();
+    if constexpr (kPropagateOnMove) {
+      allocator_ = other.allocator_;
+    }
+    StealStorage(other);
     return *this;
   }
 
   Vector& operator=(const std::initializer_list<T>& list) {
-    if (capacity_ < list.size()) {
-      auto new_buffer = operator new(list.size());
-      try {
-        std::uninitialized_move(list.begin(), list.end(), static_cast<Pointer>(new_buffer));
-      } catch (...) {
-        operator delete(new_buffer);
-        throw;
-      }
-      buffer_ = new_buffer;
-      size_ = capacity_ = list.size();
-    } else if (size_ > list.size()) {
-      std::copy(list.begin(), list.end(), static_cast<Pointer>(buffer_));
-      std::destroy(begin() + list.size(), begin() + size_);
-    } else {
-      std::move(list.begin(), list.begin() + size_, static_cast<Pointer>(buffer_));
-      std::uninitialized_move(list.begin() + size_, list.end(), static_cast<Pointer>(buffer_) + size_);
-    }
+    AssignElements(list.begin(), list.size());
     return *this;
   }
 
   ~Vector() noexcept {
     if (buffer_ != nullptr) {
       std::destroy(begin(), end());
-      operator delete(buffer_);
+      Deallocate(buffer_, capacity_);
       size_ = capacity_ = 0;
     }
   }
 
+  AllocatorType GetAllocator() const noexcept {
+    return allocator_;
+  }
+
   size_t Size() const noexcept {
     return size_;
   }
@@ -261,7 +315,20 @@ class Vector {
     return static_cast<Pointer>(buffer_);
   }
 
-  void Swap(Vector<T>& other) noexcept {
+  // Allocators are exchanged only if they propagate on swap. Vectors with unequal non-propagating allocators
+  // exchange their elements by moves, each keeping its own allocator and storage.
+  void Swap(Vector& other) noexcept(kPropagateOnSwap || kAlwaysEqual) {
+    if constexpr (!kPropagateOnSwap && !kAlwaysEqual) {
+      if (allocator_ != other.allocator_) {
+        Vector temp(std::move(other), allocator_);
+        other = std::move(*this);
+        *this = std::move(temp);
+        return;
+      }
+    }
+    if constexpr (kPropagateOnSwap) {
+      std::swap(allocator_, other.allocator_);
+    }
     std::swap(buffer_, other.buffer_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
@@ -279,12 +346,12 @@ class Vector {
       return;
     }
 
-    auto new_buffer = operator new(new_size * sizeof(ValueType));
+    auto new_buffer = Allocate(new_size);
     try {
       std::uninitialized_move(static_cast<Pointer>(buffer_), static_cast<Pointer>(buffer_) + size_,
                               static_cast<Pointer>(new_buffer));
     } catch (...) {
-      operator delete(new_buffer);
+      Deallocate(new_buffer, new_size);
     }
     try {
       std::uninitialized_default_construct(static_cast<Pointer>(new_buffer) + size_,
@@ -292,11 +359,11 @@ class Vector {
     } catch (...) {
       std::move(static_cast<Pointer>(new_buffer), static_cast<Pointer>(new_buffer) + size_,
                 static_cast<Pointer>(buffer_));
-      operator delete(new_buffer);
+      Deallocate(new_buffer, new_size);
       throw;
     }
     std::destroy(begin(), end());
-    operator delete(buffer_);
+    Deallocate(buffer_, capacity_);
     buffer_ = new_buffer;
     size_ = new_size;
     capacity_ = new_size;
@@ -312,12 +379,12 @@ class Vector {
       size_ = new_size;
       return;
     }
-    auto new_buffer = operator new(new_size * sizeof(ValueType));
+    auto new_buffer = Allocate(new_size);
     try {
       std::uninitialized_move(static_cast<Pointer>(buffer_), static_cast<Pointer>(buffer_) + size_,
                               static_cast<Pointer>(new_buffer));
     } catch (...) {
-      operator delete(new_buffer);
+      Deallocate(new_buffer, new_size);
     }
     try {
       std::uninitialized_fill(static_cast<Pointer>(new_buffer) + size_, static_cast<Pointer>(new_buffer) + new_size,
@@ -325,11 +392,11 @@ class Vector {
     } catch (...) {
       std::move(static_cast<Pointer>(new_buffer), static_cast<Pointer>(new_buffer) + size_,
                 static_cast<Pointer>(buffer_));
-      operator delete(new_buffer);
+      Deallocate(new_buffer, new_size);
       throw;
     }
     std::destroy(begin(), end());
-    operator delete(buffer_);
+    Deallocate(buffer_, capacity_);
     buffer_ = new_buffer;
     size_ = new_size;
     capacity_ = new_size;
@@ -339,15 +406,15 @@ class Vector {
     if (new_capacity <= capacity_) {
       return;
     }
-    auto new_buffer = operator new(sizeof(ValueType) * new_capacity);
+    auto new_buffer = Allocate(new_capacity);
     try {
       std::uninitialized_move(begin(), end(), static_cast<Pointer>(new_buffer));
     } catch (...) {
-      operator delete(new_buffer);
+      Deallocate(new_buffer, new_capacity);
       throw;
     }
     std::destroy(begin(), end());
-    operator delete(buffer_);
+    Deallocate(buffer_, capacity_);
     buffer_ = new_buffer;
     capacity_ = new_capacity;
   }
@@ -359,21 +426,21 @@ class Vector {
 
     if (size_ == 0) {
       std::destroy(begin(), end());
-      operator delete(buffer_);
+      Deallocate(buffer_, capacity_);
       buffer_ = nullptr;
       size_ = capacity_ = 0;
       return;
     }
 
-    auto new_buffer = operator new(sizeof(T) * size_);
+    auto new_buffer = Allocate(size_);
     try {
       std::uninitialized_move(begin(), end(), static_cast<Pointer>(new_buffer));
     } catch (...) {
-      operator delete(new_buffer);
+      Deallocate(new_buffer, size_);
       throw;
     }
     std::destroy(begin(), end());
-    operator delete(buffer_);
+    Deallocate(buffer_, capacity_);
     capacity_ = size_;
     buffer_ = new_buffer;
   }
@@ -398,12 +465,12 @@ class Vector {
       new (static_cast<Pointer>(new_buffer) + size_) T(value);
     } catch (...) {
       std::destroy_n(static_cast<Pointer>(new_buffer), size_);
-      operator delete(new_buffer);
+      Deallocate(new_buffer, NextCapacity());
       throw;
     }
-    capacity_ = (capacity_ == 0) ? 1 : capacity_ * 2;
     std::destroy(begin(), end());
-    operator delete(buffer_);
+    Deallocate(buffer_, capacity_);
+    capacity_ = NextCapacity();
     buffer_ = new_buffer;
     size_++;
   }
@@ -421,12 +488,12 @@ class Vector {
       new (static_cast<Pointer>(new_buffer) + size_) T(std::move(value));
     } catch (...) {
       std::destroy_n(static_cast<Pointer>(new_buffer), size_);
-      operator delete(new_buffer);
+      Deallocate(new_buffer, NextCapacity());
       throw;
     }
-    capacity_ = (capacity_ == 0) ? 1 : capacity_ * 2;
     std::destroy(begin(), end());
-    operator delete(buffer_);
+    Deallocate(buffer_, capacity_);
+    capacity_ = NextCapacity();
     buffer_ = new_buffer;
     size_++;
   }
@@ -446,12 +513,12 @@ class Vector {
     } catch (...) {
       std::uninitialized_move(static_cast<Pointer>(new_buffer), static_cast<Pointer>(new_buffer) + size_,
                               static_cast<Pointer>(buffer_));
-      operator delete(new_buffer);
+      Deallocate(new_buffer, NextCapacity());
       throw;
     }
-    capacity_ = (capacity_ == 0) ? 1 : capacity_ * 2;
     std::destroy(begin(), end());
-    operator delete(buffer_);
+    Deallocate(buffer_, capacity_);
+    capacity_ = NextCapacity();
     buffer_ = new_buffer;
     size_++;
   }
@@ -506,8 +573,8 @@ class Vector {
   }
 };
 
-template <typename T>
-bool operator<(const Vector<T>& first, const Vector<T>& second) {
+template <typename T, class Allocator>
+bool operator<(const Vector<T, Allocator>& first, const Vector<T, Allocator>& second) {
   size_t end = std::min(first.size_, second.size_);
   for (size_t idx = 0; idx < end; ++idx) {
     if (first[idx] < second[idx]) {
@@ -520,8 +587,8 @@ bool operator<(const Vector<T>& first, const Vector<T>& second) {
   return static_cast<bool>(first.size_ < second.size_);
 }
 
-template <typename T>
-bool operator==(const Vector<T>& first, const Vector<T>& second) {
+template <typename T, class Allocator>
+bool operator==(const Vector<T, Allocator>& first, const Vector<T, Allocator>& second) {
   if (first.size_ != second.size_) {
     return false;
   }
@@ -533,22 +600,22 @@ bool operator==(const Vector<T>& first, const Vector<T>& second) {
   return true;
 }
 
-template <typename T>
-bool operator>=(const Vector<T>& first, const Vector<T>& second) {
+template <typename T, class Allocator>
+bool operator>=(const Vector<T, Allocator>& first, const Vector<T, Allocator>& second) {
   return !(first < second);
 }
 
-template <typename T>
-bool operator>(const Vector<T>& first, const Vector<T>& second) {
+template <typename T, class Allocator>
+bool operator>(const Vector<T, Allocator>& first, const Vector<T, Allocator>& second) {
   return (!(first < second) && !(first == second));
 }
 
-template <typename T>
-bool operator<=(const Vector<T>& first, const Vector<T>& second) {
+template <typename T, class Allocator>
+bool operator<=(const Vector<T, Allocator>& first, const Vector<T, Allocator>& second) {
   return (first < second || first == second);
 }
 
-template <typename T>
-bool operator!=(const Vector<T>& first, const Vector<T>& second) {
+template <typename T, class Allocator>
+bool operator!=(const Vector<T, Allocator>& first, const Vector<T, Allocator>& second) {
   return !(first == second);
 }